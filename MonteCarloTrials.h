@@ -0,0 +1,58 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+/**
+ * Runs independent Monte-Carlo trials on all the hardware threads and returns the sum of their histograms.
+ *
+ * The trial function is called as trial(rand, histogram) once per trial. Every thread gets its own
+ * std::mt19937 seeded from a common random seed and the thread index, and its own histogram,
+ * so the trial function should only read shared state.
+ * Histogram should be a value-initializable container of counters, e.g. std::array<int, N>.
+ */
+template<typename Histogram, typename TrialFunc>
+Histogram runParallelTrials(int trialsCount, TrialFunc trial)
+{
+	const uint32_t seed = std::random_device{}();
+	const int threadsCount = std::max(1, std::min(trialsCount, static_cast<int>(std::thread::hardware_concurrency())));
+
+	std::vector<Histogram> threadHistograms(static_cast<size_t>(threadsCount), Histogram{});
+	std::vector<std::thread> threads;
+	threads.reserve(static_cast<size_t>(threadsCount));
+	for (int threadIndex = 0; threadIndex < threadsCount; ++threadIndex)
+	{
+		// distribute the remainder over the first threads
+		const int threadTrialsCount = trialsCount / threadsCount + (threadIndex < trialsCount % threadsCount ? 1 : 0);
+		threads.emplace_back([seed, threadIndex, threadTrialsCount, &trial, &histogram = threadHistograms[static_cast<size_t>(threadIndex)]]
+		{
+			std::seed_seq seedSequence{seed, static_cast<uint32_t>(threadIndex)};
+			std::mt19937 rand(seedSequence);
+			for (int i = 0; i < threadTrialsCount; ++i)
+			{
+				trial(rand, histogram);
+			}
+		});
+	}
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	Histogram result{};
+	for (const Histogram& histogram : threadHistograms)
+	{
+		auto resultIt = std::begin(result);
+		for (const auto& count : histogram)
+		{
+			*resultIt += count;
+			++resultIt;
+		}
+	}
+	return result;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <bitset>
+#include <cassert>
+#include <cstddef>
+
+#include "sampler-extensions/skip_ahead_sampling.h"
+#include "sampler-extensions/weighted_bulk_sampling.h"
+
+/**
+ * Positions of a block that were passed to the sampler, bit i is set if the element i of the block was considered
+ */
+template<size_t BlockSize>
+using BlockAcceptMask = std::bitset<BlockSize>;
+
+/**
+ * Feeds a block of count <= BlockSize elements to a uniform sampler (ReservoirSampler or ReservoirSamplerStatic).
+ * The rejected runs are skipped with one random draw per accepted element instead of one per element,
+ * so getValue(index) is called only for the accepted positions. Returns the accepted positions.
+ */
+template<size_t BlockSize, typename Sampler, typename ValueFunc>
+BlockAcceptMask<BlockSize> sampleBlockWith(Sampler& sampler, size_t count, ValueFunc&& getValue)
+{
+	assert(count <= BlockSize);
+
+	BlockAcceptMask<BlockSize> acceptMask;
+	sampleElementsSkippingWith(sampler, count, [&acceptMask, &getValue](size_t index) -> decltype(auto)
+	{
+		acceptMask.set(index);
+		return getValue(index);
+	});
+	return acceptMask;
+}
+
+/**
+ * Feeds a block of count <= BlockSize weighted elements to a weighted sampler (ReservoirSamplerWeighted
+ * or ReservoirSamplerWeightedStatic). Only the weight column is read for the rejected elements,
+ * getValue(index) is called only for the accepted positions. Returns the accepted positions.
+ */
+template<size_t BlockSize, typename WeightedSampler, typename Weight, typename ValueFunc>
+BlockAcceptMask<BlockSize> sampleWeightedBlockWith(WeightedSampler& sampler, const Weight* weights, size_t count, ValueFunc&& getValue)
+{
+	assert(count <= BlockSize);
+
+	BlockAcceptMask<BlockSize> acceptMask;
+	sampleElementsWith(sampler, weights, count, [&acceptMask, &getValue](size_t index) -> decltype(auto)
+	{
+		acceptMask.set(index);
+		return getValue(index);
+	});
+	return acceptMask;
+}
+
+/**
+ * Feeds a block of count <= BlockSize values to a uniform sampler, only the accepted values are copied
+ */
+template<size_t BlockSize, typename Sampler, typename T>
+BlockAcceptMask<BlockSize> sampleBlock(Sampler& sampler, const T* values, size_t count)
+{
+	return sampleBlockWith<BlockSize>(sampler, count, [values](size_t index) -> const T& { return values[index]; });
+}
+
+/**
+ * Feeds a block of count <= BlockSize weighted values to a weighted sampler, only the accepted values are copied
+ */
+template<size_t BlockSize, typename WeightedSampler, typename Weight, typename T>
+BlockAcceptMask<BlockSize> sampleWeightedBlock(WeightedSampler& sampler, const Weight* weights, const T* values, size_t count)
+{
+	return sampleWeightedBlockWith<BlockSize>(sampler, weights, count, [values](size_t index) -> const T& { return values[index]; });
+}
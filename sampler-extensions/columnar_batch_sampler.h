@@ -0,0 +1,183 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "reservoir-sampler/reservoir_sampler.h"
+#include "reservoir-sampler/reservoir_sampler_weighted.h"
+
+#include "sampler-extensions/skip_ahead_sampling.h"
+#include "sampler-extensions/weighted_bulk_sampling.h"
+
+/**
+ * Batch of a columnar table. Only the row count and the optional weight column are needed for sampling,
+ * the value columns are gathered by the caller using the sampled row indices.
+ */
+template<typename Weight = float>
+struct ColumnarBatch
+{
+	size_t rowsCount = 0;
+	// one non-negative weight per row, or nullptr if all the rows have equal weights
+	const Weight* weights = nullptr;
+};
+
+/**
+ * Position of a sampled row: index of the batch in the order they were sampled, and index of the row in the batch
+ */
+struct SampledRow
+{
+	uint64_t batchIndex = 0;
+	uint64_t rowIndex = 0;
+
+	friend bool operator==(const SampledRow& left, const SampledRow& right)
+	{
+		return left.batchIndex == right.batchIndex && left.rowIndex == right.rowIndex;
+	}
+
+	friend bool operator<(const SampledRow& left, const SampledRow& right)
+	{
+		return left.batchIndex < right.batchIndex || (left.batchIndex == right.batchIndex && left.rowIndex < right.rowIndex);
+	}
+};
+
+/**
+ * Samples rows from a stream of columnar batches without constructing row objects.
+ * Uniform samplers skip runs of rows in constant time, weighted samplers read only the weight column.
+ * Use through ColumnarBatchSamplerUniform and ColumnarBatchSamplerWeighted aliases.
+ */
+template<typename Sampler, typename Weight = float>
+class ColumnarBatchSampler
+{
+public:
+	// arguments are forwarded to the underlying sampler, copies and moves use the implicit constructors
+	template<typename... SamplerArgs, typename = std::enable_if_t<!(std::is_same_v<std::decay_t<SamplerArgs>, ColumnarBatchSampler> || ...)>>
+	explicit ColumnarBatchSampler(SamplerArgs&&... samplerArguments)
+		: mSampler(std::forward<SamplerArgs>(samplerArguments)...)
+	{
+	}
+
+	/**
+	 * Samples rows of the batch. Uniform samplers ignore the weight column,
+	 * weighted samplers use weight of one for batches without a weight column.
+	 */
+	void sampleBatch(const ColumnarBatch<Weight>& batch)
+	{
+		const uint64_t batchIndex = mProcessedBatchesCount;
+		auto makeRow = [batchIndex](size_t rowIndex) { return SampledRow{batchIndex, static_cast<uint64_t>(rowIndex)}; };
+
+		if constexpr (requires(Sampler& sampler) { sampler.willNextElementBeConsidered(); })
+		{
+			// the rest of a skip that goes past the end of the batch continues in the next batch
+			sampleElementsSkippingWith(mSampler, batch.rowsCount, makeRow);
+		}
+		else if (batch.weights != nullptr)
+		{
+			sampleElementsWith(mSampler, batch.weights, batch.rowsCount, makeRow);
+		}
+		else
+		{
+			const Weight unitWeight(1);
+			for (size_t rowIndex = 0; rowIndex < batch.rowsCount; ++rowIndex)
+			{
+				if (mSampler.willNextElementBeConsidered(unitWeight))
+				{
+					mSampler.sampleElement(unitWeight, makeRow(rowIndex));
+				}
+				else
+				{
+					mSampler.skipNextElement(unitWeight);
+				}
+			}
+		}
+
+		++mProcessedBatchesCount;
+	}
+
+	[[nodiscard]] size_t getResultSize() const
+	{
+		return mSampler.getResultSize();
+	}
+
+	[[nodiscard]] uint64_t getProcessedBatchesCount() const
+	{
+		return mProcessedBatchesCount;
+	}
+
+	/**
+	 * Returns the sampled rows sorted by batch and row, and resets the sampler
+	 */
+	[[nodiscard]] std::vector<SampledRow> consumeSampledRows()
+	{
+		std::vector<SampledRow> rows = mSampler.consumeResult();
+		std::sort(rows.begin(), rows.end());
+		mProcessedBatchesCount = 0;
+		return rows;
+	}
+
+	void reset()
+	{
+		mSampler.reset();
+		mProcessedBatchesCount = 0;
+	}
+
+private:
+	Sampler mSampler;
+	uint64_t mProcessedBatchesCount = 0;
+};
+
+template<typename Rand = std::mt19937, typename Weight = float>
+using ColumnarBatchSamplerUniform = ColumnarBatchSampler<ReservoirSampler<SampledRow, Rand>, Weight>;
+
+template<typename Weight = float, typename Rand = std::mt19937>
+using ColumnarBatchSamplerWeighted = ColumnarBatchSampler<ReservoirSamplerWeighted<SampledRow, Weight, Rand>, Weight>;
+
+/**
+ * Samples row indices of a single batch, the result is sorted
+ */
+template<typename Weight, typename Rand>
+std::vector<size_t> sampleRowIndices(const ColumnarBatch<Weight>& batch, size_t sampleSize, Rand& rand)
+{
+	std::vector<SampledRow> rows;
+	if (batch.weights != nullptr)
+	{
+		ColumnarBatchSamplerWeighted<Weight, Rand&> sampler(sampleSize, rand);
+		sampler.sampleBatch(batch);
+		rows = sampler.consumeSampledRows();
+	}
+	else
+	{
+		ColumnarBatchSamplerUniform<Rand&, Weight> sampler(sampleSize, rand);
+		sampler.sampleBatch(batch);
+		rows = sampler.consumeSampledRows();
+	}
+
+	std::vector<size_t> rowIndices;
+	rowIndices.reserve(rows.size());
+	for (const SampledRow& row : rows)
+	{
+		rowIndices.push_back(static_cast<size_t>(row.rowIndex));
+	}
+	return rowIndices;
+}
+
+/**
+ * Gathers values of one column for the sampled rows.
+ * getColumn(batchIndex) should return a pointer to the column buffer of that batch.
+ */
+template<typename T, typename GetColumnFunc>
+std::vector<T> gatherSampledRows(const std::vector<SampledRow>& rows, GetColumnFunc&& getColumn)
+{
+	std::vector<T> values;
+	values.reserve(rows.size());
+	for (const SampledRow& row : rows)
+	{
+		const T* column = getColumn(row.batchIndex);
+		values.push_back(column[row.rowIndex]);
+	}
+	return values;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+/**
+ * SplitMix64 generator that can be used in constant evaluation.
+ * Satisfies UniformRandomBitGenerator, so it can be used as Rand for any of the samplers.
+ */
+class SplitMix64
+{
+public:
+	using result_type = uint64_t;
+
+public:
+	constexpr SplitMix64() = default;
+	constexpr explicit SplitMix64(uint64_t seed)
+		: mState(seed)
+	{
+	}
+
+	static constexpr result_type min() { return std::numeric_limits<result_type>::min(); }
+	static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+	constexpr result_type operator()()
+	{
+		mState += 0x9E3779B97F4A7C15ull;
+		uint64_t result = mState;
+		result = (result ^ (result >> 30)) * 0xBF58476D1CE4E5B9ull;
+		result = (result ^ (result >> 27)) * 0x94D049BB133111EBull;
+		return result ^ (result >> 31);
+	}
+
+private:
+	uint64_t mState = 0;
+};
+
+/**
+ * Returns a uniformly distributed number in [0, bound) using a generator of 64 bit numbers.
+ * Bitmask rejection: the loop runs less than two times on average.
+ * Unlike std::uniform_int_distribution can be used in constant evaluation.
+ */
+template<typename Rand>
+constexpr uint64_t getBoundedRandom(Rand& rand, uint64_t bound)
+{
+	static_assert(Rand::min() == 0 && Rand::max() == std::numeric_limits<uint64_t>::max(), "The generator should produce 64 random bits");
+
+	uint64_t mask = bound - 1;
+	mask |= mask >> 1;
+	mask |= mask >> 2;
+	mask |= mask >> 4;
+	mask |= mask >> 8;
+	mask |= mask >> 16;
+	mask |= mask >> 32;
+
+	uint64_t result = rand() & mask;
+	while (result >= bound)
+	{
+		result = rand() & mask;
+	}
+	return result;
+}
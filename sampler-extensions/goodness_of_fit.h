@@ -0,0 +1,217 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+/**
+ * Goodness-of-fit checks for validating distributions produced by samplers.
+ * Don't depend on gtest, so they can be used from unit tests as well as from standalone tools.
+ */
+
+struct GoodnessOfFitResult
+{
+	double statistic = 0.0;
+	// probability to get a statistic at least this extreme if the expected distribution is correct
+	double pValue = 1.0;
+};
+
+/**
+ * Regularized upper incomplete gamma function Q(a, x)
+ */
+inline double getUpperIncompleteGammaRatio(double a, double x)
+{
+	constexpr int MaxIterations = 1000;
+	constexpr double Epsilon = 1e-15;
+	constexpr double TinyValue = std::numeric_limits<double>::min() / Epsilon;
+
+	if (x <= 0.0)
+	{
+		return 1.0;
+	}
+
+	const double logPrefix = -x + a * std::log(x) - std::lgamma(a);
+
+	if (x < a + 1.0)
+	{
+		// series for the lower function converges fast here
+		double term = 1.0 / a;
+		double sum = term;
+		for (int i = 1; i < MaxIterations; ++i)
+		{
+			term *= x / (a + i);
+			sum += term;
+			if (std::abs(term) < std::abs(sum) * Epsilon)
+			{
+				break;
+			}
+		}
+		return std::max(0.0, 1.0 - sum * std::exp(logPrefix));
+	}
+
+	// continued fraction for the upper function, evaluated with the modified Lentz's method
+	double b = x + 1.0 - a;
+	double c = 1.0 / TinyValue;
+	double d = 1.0 / b;
+	double fraction = d;
+	for (int i = 1; i < MaxIterations; ++i)
+	{
+		const double an = -i * (i - a);
+		b += 2.0;
+		d = an * d + b;
+		d = (std::abs(d) < TinyValue) ? TinyValue : d;
+		c = b + an / c;
+		c = (std::abs(c) < TinyValue) ? TinyValue : c;
+		d = 1.0 / d;
+		const double delta = d * c;
+		fraction *= delta;
+		if (std::abs(delta - 1.0) < Epsilon)
+		{
+			break;
+		}
+	}
+	return std::min(1.0, std::exp(logPrefix) * fraction);
+}
+
+/**
+ * Probability that a chi-square distributed value with the given degrees of freedom is at least the statistic
+ */
+inline double getChiSquarePValue(double statistic, double degreesOfFreedom)
+{
+	return getUpperIncompleteGammaRatio(degreesOfFreedom * 0.5, statistic * 0.5);
+}
+
+/**
+ * Probability that the Kolmogorov distributed value is at least lambda
+ */
+inline double getKolmogorovPValue(double lambda)
+{
+	// the series converges too slowly for small values, but the result is indistinguishable from one there
+	if (lambda < 0.27)
+	{
+		return 1.0;
+	}
+
+	double sum = 0.0;
+	double sign = 1.0;
+	for (int j = 1; j <= 100; ++j)
+	{
+		const double term = std::exp(-2.0 * j * j * lambda * lambda);
+		sum += sign * term;
+		if (term < 1e-16)
+		{
+			break;
+		}
+		sign = -sign;
+	}
+	return std::clamp(2.0 * sum, 0.0, 1.0);
+}
+
+/**
+ * Pearson's chi-square test of counts of independent trials with one outcome each (e.g. a single-element sampler)
+ * against the expected outcome probabilities. Categories with zero expected probability are ignored.
+ */
+template<typename Counts, typename Probabilities>
+GoodnessOfFitResult chiSquareTest(const Counts& observedCounts, const Probabilities& expectedProbabilities)
+{
+	double trialsCount = 0.0;
+	for (const auto& count : observedCounts)
+	{
+		trialsCount += static_cast<double>(count);
+	}
+
+	GoodnessOfFitResult result;
+	size_t categoriesCount = 0;
+	auto probabilityIt = std::begin(expectedProbabilities);
+	for (const auto& count : observedCounts)
+	{
+		const double expectedCount = trialsCount * static_cast<double>(*probabilityIt);
+		++probabilityIt;
+		if (expectedCount > 0.0)
+		{
+			const double difference = static_cast<double>(count) - expectedCount;
+			result.statistic += difference * difference / expectedCount;
+			++categoriesCount;
+		}
+	}
+
+	if (categoriesCount > 1)
+	{
+		result.pValue = getChiSquarePValue(result.statistic, static_cast<double>(categoriesCount - 1));
+	}
+	return result;
+}
+
+/**
+ * Chi-square test that sampling without replacement includes every element of the population with equal probability.
+ *
+ * inclusionCounts contains how many times every element was included into the sample over all the trials,
+ * every trial sampling sampleSize distinct elements. Plain Pearson's test would be too conservative here, since
+ * the counts of elements sampled together in one trial are negatively correlated, so the statistic is
+ * normalized by the variance of the multivariate hypergeometric distribution.
+ */
+template<typename Counts>
+GoodnessOfFitResult chiSquareUniformInclusionTest(const Counts& inclusionCounts, size_t sampleSize)
+{
+	double populationSize = 0.0;
+	double totalCount = 0.0;
+	for (const auto& count : inclusionCounts)
+	{
+		totalCount += static_cast<double>(count);
+		populationSize += 1.0;
+	}
+
+	GoodnessOfFitResult result;
+	if (sampleSize == 0 || populationSize <= static_cast<double>(sampleSize))
+	{
+		// every element is always included, there is nothing to test
+		return result;
+	}
+
+	const double trialsCount = totalCount / static_cast<double>(sampleSize);
+	const double inclusionProbability = static_cast<double>(sampleSize) / populationSize;
+	const double expectedCount = trialsCount * inclusionProbability;
+	const double variance = expectedCount * (1.0 - inclusionProbability) * populationSize / (populationSize - 1.0);
+
+	for (const auto& count : inclusionCounts)
+	{
+		const double difference = static_cast<double>(count) - expectedCount;
+		result.statistic += difference * difference / variance;
+	}
+
+	result.pValue = getChiSquarePValue(result.statistic, populationSize - 1.0);
+	return result;
+}
+
+/**
+ * One-sample Kolmogorov-Smirnov test of the values against a continuous cumulative distribution function.
+ * For discrete distributions the test is conservative.
+ */
+template<typename Cdf>
+GoodnessOfFitResult kolmogorovSmirnovTest(std::vector<double> values, Cdf&& cdf)
+{
+	GoodnessOfFitResult result;
+	if (values.empty())
+	{
+		return result;
+	}
+
+	std::sort(values.begin(), values.end());
+
+	const double size = static_cast<double>(values.size());
+	for (size_t i = 0; i < values.size(); ++i)
+	{
+		const double expected = cdf(values[i]);
+		const double distanceBelow = expected - static_cast<double>(i) / size;
+		const double distanceAbove = static_cast<double>(i + 1) / size - expected;
+		result.statistic = std::max(result.statistic, std::max(distanceBelow, distanceAbove));
+	}
+
+	// asymptotic distribution with a correction that makes it accurate for small sizes
+	const double sqrtSize = std::sqrt(size);
+	result.pValue = getKolmogorovPValue((sqrtSize + 0.12 + 0.11 / sqrtSize) * result.statistic);
+	return result;
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+/**
+ * Philox4x32-10 counter-based generator.
+ * Satisfies UniformRandomBitGenerator, so it can be used as Rand for any of the samplers.
+ *
+ * Every output block is a bijection of a 128 bit counter under a key, so generators don't share any state:
+ * the key is taken from the seed and the upper half of the counter from the stream id, which gives
+ * each (seed, streamId) pair an independent substream of 2^66 numbers. Shards or threads that use
+ * their index as the stream id produce the same results regardless of how they are scheduled.
+ */
+class Philox4x32
+{
+public:
+	using result_type = uint32_t;
+	using Block = std::array<uint32_t, 4>;
+	using Key = std::array<uint32_t, 2>;
+
+public:
+	constexpr Philox4x32() = default;
+	constexpr explicit Philox4x32(uint64_t seed, uint64_t streamId = 0)
+		: mKey{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)}
+		, mCounter{0, 0, static_cast<uint32_t>(streamId), static_cast<uint32_t>(streamId >> 32)}
+	{
+	}
+
+	static constexpr result_type min() { return std::numeric_limits<result_type>::min(); }
+	static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+	constexpr result_type operator()()
+	{
+		if (mOutputIndex == mOutput.size())
+		{
+			generateNextBlock();
+			mOutputIndex = 0;
+		}
+		return mOutput[mOutputIndex++];
+	}
+
+	/**
+	 * Skips the given amount of numbers in constant time
+	 */
+	constexpr void discard(unsigned long long count)
+	{
+		const size_t bufferedCount = mOutput.size() - mOutputIndex;
+		if (count <= bufferedCount)
+		{
+			mOutputIndex += static_cast<size_t>(count);
+			return;
+		}
+
+		count -= bufferedCount;
+		addToBlockIndex(count / mOutput.size());
+		generateNextBlock();
+		mOutputIndex = static_cast<size_t>(count % mOutput.size());
+	}
+
+	/**
+	 * Applies the Philox4x32-10 bijection to a counter
+	 */
+	static constexpr Block getBlock(Block counter, Key key)
+	{
+		constexpr uint32_t Multiplier0 = 0xD2511F53u;
+		constexpr uint32_t Multiplier1 = 0xCD9E8D57u;
+		constexpr uint32_t KeyIncrement0 = 0x9E3779B9u;
+		constexpr uint32_t KeyIncrement1 = 0xBB67AE85u;
+		constexpr int RoundsCount = 10;
+
+		for (int round = 0; round < RoundsCount; ++round)
+		{
+			if (round > 0)
+			{
+				key[0] += KeyIncrement0;
+				key[1] += KeyIncrement1;
+			}
+
+			const uint64_t product0 = static_cast<uint64_t>(Multiplier0) * counter[0];
+			const uint64_t product1 = static_cast<uint64_t>(Multiplier1) * counter[2];
+			counter = {
+				static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+				static_cast<uint32_t>(product1),
+				static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+				static_cast<uint32_t>(product0)
+			};
+		}
+		return counter;
+	}
+
+	friend constexpr bool operator==(const Philox4x32& left, const Philox4x32& right)
+	{
+		return left.mKey == right.mKey && left.mCounter == right.mCounter && left.mOutputIndex == right.mOutputIndex;
+	}
+
+	friend constexpr bool operator!=(const Philox4x32& left, const Philox4x32& right)
+	{
+		return !(left == right);
+	}
+
+private:
+	constexpr void generateNextBlock()
+	{
+		mOutput = getBlock(mCounter, mKey);
+		addToBlockIndex(1);
+	}
+
+	constexpr void addToBlockIndex(uint64_t count)
+	{
+		// the lower half of the counter is the block index within the stream
+		const uint64_t blockIndex = ((static_cast<uint64_t>(mCounter[1]) << 32) | mCounter[0]) + count;
+		mCounter[0] = static_cast<uint32_t>(blockIndex);
+		mCounter[1] = static_cast<uint32_t>(blockIndex >> 32);
+	}
+
+private:
+	Key mKey{};
+	Block mCounter{};
+	Block mOutput{};
+	size_t mOutputIndex = mOutput.size();
+};
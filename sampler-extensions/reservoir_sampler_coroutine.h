@@ -0,0 +1,250 @@
+#pragma once
+
+#if __has_include(<version>)
+#include <version>
+#endif
+
+#if defined(__cpp_impl_coroutine) && defined(__cpp_lib_coroutine)
+
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Lazy generator of values, created by coroutines that use co_yield
+ */
+template<typename T>
+class SampleGenerator
+{
+public:
+	class promise_type
+	{
+	public:
+		SampleGenerator get_return_object() { return SampleGenerator(std::coroutine_handle<promise_type>::from_promise(*this)); }
+		std::suspend_always initial_suspend() noexcept { return {}; }
+		std::suspend_always final_suspend() noexcept { return {}; }
+		void return_void() noexcept {}
+		void unhandled_exception() { mException = std::current_exception(); }
+
+		std::suspend_always yield_value(T& value) noexcept
+		{
+			mCurrentValue = std::addressof(value);
+			return {};
+		}
+
+		std::suspend_always yield_value(T&& value) noexcept
+		{
+			mCurrentValue = std::addressof(value);
+			return {};
+		}
+
+		// co_await is not supported inside generators
+		template<typename U>
+		std::suspend_never await_transform(U&&) = delete;
+
+	private:
+		friend class SampleGenerator;
+
+		T* mCurrentValue = nullptr;
+		std::exception_ptr mException;
+	};
+
+	class Iterator
+	{
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = T*;
+		using reference = T&;
+
+		Iterator() = default;
+		explicit Iterator(std::coroutine_handle<promise_type> coroutine)
+			: mCoroutine(coroutine)
+		{
+		}
+
+		reference operator*() const { return *mCoroutine.promise().mCurrentValue; }
+		pointer operator->() const { return mCoroutine.promise().mCurrentValue; }
+
+		Iterator& operator++()
+		{
+			resumeCoroutine(mCoroutine);
+			return *this;
+		}
+
+		void operator++(int) { ++*this; }
+
+		friend bool operator==(const Iterator& iterator, std::default_sentinel_t) { return !iterator.mCoroutine || iterator.mCoroutine.done(); }
+
+	private:
+		std::coroutine_handle<promise_type> mCoroutine;
+	};
+
+public:
+	SampleGenerator(const SampleGenerator&) = delete;
+	SampleGenerator& operator=(const SampleGenerator&) = delete;
+
+	SampleGenerator(SampleGenerator&& other) noexcept
+		: mCoroutine(std::exchange(other.mCoroutine, {}))
+	{
+	}
+
+	SampleGenerator& operator=(SampleGenerator&& other) noexcept
+	{
+		if (this != &other)
+		{
+			destroyCoroutine();
+			mCoroutine = std::exchange(other.mCoroutine, {});
+		}
+		return *this;
+	}
+
+	~SampleGenerator()
+	{
+		destroyCoroutine();
+	}
+
+	/**
+	 * Starts the generator, can be called only once
+	 */
+	Iterator begin()
+	{
+		resumeCoroutine(mCoroutine);
+		return Iterator(mCoroutine);
+	}
+
+	std::default_sentinel_t end() const noexcept { return {}; }
+
+private:
+	explicit SampleGenerator(std::coroutine_handle<promise_type> coroutine)
+		: mCoroutine(coroutine)
+	{
+	}
+
+	static void resumeCoroutine(std::coroutine_handle<promise_type> coroutine)
+	{
+		if (coroutine && !coroutine.done())
+		{
+			coroutine.resume();
+			if (coroutine.promise().mException)
+			{
+				std::rethrow_exception(std::exchange(coroutine.promise().mException, {}));
+			}
+		}
+	}
+
+	void destroyCoroutine()
+	{
+		if (mCoroutine)
+		{
+			mCoroutine.destroy();
+		}
+	}
+
+private:
+	std::coroutine_handle<promise_type> mCoroutine;
+};
+
+/**
+ * Exposes a uniform sampler (e.g. ReservoirSampler) as an awaitable sink for coroutine pipelines.
+ *
+ * `co_await sink.push(value)` never suspends: the sampler decides synchronously whether the element
+ * is considered, and the producer is resumed right away. Rejected elements are skipped using
+ * the skip-ahead interface without being copied or moved, and for pushEmplace() without being constructed.
+ * The sink doesn't own the sampler, the sampler should outlive the sink and the awaitables.
+ */
+template<typename Sampler>
+class SamplerSink
+{
+public:
+	/**
+	 * Awaitable that forwards the element to the sampler when awaited.
+	 * The result of co_await is true if the element was added to the sample.
+	 */
+	template<typename... Args>
+	class [[nodiscard]] PushAwaitable
+	{
+	public:
+		PushAwaitable(Sampler& sampler, Args&&... arguments)
+			: mSampler(sampler)
+			, mArguments(std::forward<Args>(arguments)...)
+		{
+		}
+
+		bool await_ready() const noexcept { return true; }
+		void await_suspend(std::coroutine_handle<>) const noexcept {}
+
+		bool await_resume()
+		{
+			if (!mSampler.willNextElementBeConsidered())
+			{
+				mSampler.skipNextElement();
+				return false;
+			}
+
+			std::apply([this](Args&&... arguments)
+			{
+				mSampler.sampleElementEmplace(std::forward<Args>(arguments)...);
+			}, std::move(mArguments));
+			return true;
+		}
+
+	private:
+		Sampler& mSampler;
+		// references stay valid, temporaries live until the end of the full co_await expression
+		std::tuple<Args&&...> mArguments;
+	};
+
+public:
+	explicit SamplerSink(Sampler& sampler)
+		: mSampler(sampler)
+	{
+	}
+
+	template<typename T>
+	PushAwaitable<T> push(T&& value)
+	{
+		return PushAwaitable<T>(mSampler, std::forward<T>(value));
+	}
+
+	/**
+	 * Constructs the element from the arguments only if the sampler is going to consider it
+	 */
+	template<typename... Args>
+	PushAwaitable<Args...> pushEmplace(Args&&... arguments)
+	{
+		return PushAwaitable<Args...>(mSampler, std::forward<Args>(arguments)...);
+	}
+
+	/**
+	 * Consumes the result of the sampler and returns a generator that yields the sampled elements.
+	 * The generator owns the consumed result, so it can outlive the sink and the sampler.
+	 */
+	auto results() -> SampleGenerator<typename std::decay_t<decltype(std::declval<Sampler&>().consumeResult())>::value_type>
+	{
+		return yieldElements(mSampler.consumeResult());
+	}
+
+	Sampler& getSampler() { return mSampler; }
+
+private:
+	// takes the result by value, so it is stored in the coroutine frame and not referenced through the sink
+	template<typename Result>
+	static SampleGenerator<typename Result::value_type> yieldElements(Result result)
+	{
+		for (auto& element : result)
+		{
+			co_yield std::move(element);
+		}
+	}
+
+private:
+	Sampler& mSampler;
+};
+
+#endif // __cpp_impl_coroutine && __cpp_lib_coroutine
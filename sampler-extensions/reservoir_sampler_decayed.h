@@ -0,0 +1,155 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+/**
+ * Weighted reservoir sampler with exponential forward decay.
+ *
+ * An element with timestamp t gets weight exp(decayRate * (t - landmark)), so newer elements are
+ * proportionally more likely to be in the sample and the old ones are never fully forgotten.
+ * This is the same priority-key sampling as in ReservoirSamplerWeighted (keep k elements with
+ * the smallest Exp(1)/weight keys), but the keys are kept in log space: log(key) = log(Exp(1)) - decayRate * (t - landmark).
+ * That avoids the overflow of exp() for growing timestamps, and when the exponent gets too large
+ * the landmark is moved forward and all stored keys are shifted by the same amount, which keeps their order.
+ *
+ * Uses memory for sampleSize elements, adding an element takes O(log sampleSize).
+ */
+template<typename T, typename Rand = std::mt19937>
+class ReservoirSamplerDecayed
+{
+public:
+	ReservoirSamplerDecayed(size_t sampleSize, double decayRate)
+		: mSampleSize(sampleSize)
+		, mDecayRate(decayRate)
+	{
+		mData.reserve(sampleSize);
+	}
+
+	template<typename RandArg>
+	ReservoirSamplerDecayed(size_t sampleSize, double decayRate, RandArg&& rand)
+		: mSampleSize(sampleSize)
+		, mDecayRate(decayRate)
+		, mRand(std::forward<RandArg>(rand))
+	{
+		mData.reserve(sampleSize);
+	}
+
+	void sampleElement(double timestamp, const T& value)
+	{
+		sampleElementEmplace(timestamp, value);
+	}
+
+	void sampleElement(double timestamp, T&& value)
+	{
+		sampleElementEmplace(timestamp, std::move(value));
+	}
+
+	template<typename... Args>
+	void sampleElementEmplace(double timestamp, Args&&... arguments)
+	{
+		if (mSampleSize == 0)
+		{
+			return;
+		}
+
+		if (!mHasLandmark)
+		{
+			mLandmark = timestamp;
+			mHasLandmark = true;
+		}
+		else if (mDecayRate * (timestamp - mLandmark) > MaxExponent)
+		{
+			moveLandmark(timestamp);
+		}
+
+		std::exponential_distribution<double> distribution(1.0);
+		const double logKey = std::log(distribution(mRand)) - mDecayRate * (timestamp - mLandmark);
+
+		if (mData.size() < mSampleSize)
+		{
+			mData.emplace_back(std::piecewise_construct, std::forward_as_tuple(logKey), std::forward_as_tuple(std::forward<Args>(arguments)...));
+			std::push_heap(mData.begin(), mData.end(), IsKeyLess);
+		}
+		else if (logKey < mData.front().first)
+		{
+			// replace the element with the largest key
+			std::pop_heap(mData.begin(), mData.end(), IsKeyLess);
+			mData.back() = Element(std::piecewise_construct, std::forward_as_tuple(logKey), std::forward_as_tuple(std::forward<Args>(arguments)...));
+			std::push_heap(mData.begin(), mData.end(), IsKeyLess);
+		}
+	}
+
+	[[nodiscard]] std::vector<T> getResult() const
+	{
+		std::vector<T> result;
+		result.reserve(mData.size());
+		for (const Element& element : mData)
+		{
+			result.push_back(element.second);
+		}
+		return result;
+	}
+
+	[[nodiscard]] size_t getResultSize() const
+	{
+		return mData.size();
+	}
+
+	[[nodiscard]] std::vector<T> consumeResult()
+	{
+		std::vector<T> result;
+		result.reserve(mData.size());
+		for (Element& element : mData)
+		{
+			result.push_back(std::move(element.second));
+		}
+		reset();
+		return result;
+	}
+
+	[[nodiscard]] double getLandmark() const
+	{
+		return mLandmark;
+	}
+
+	void reset()
+	{
+		mData.clear();
+		mHasLandmark = false;
+		mLandmark = 0.0;
+	}
+
+private:
+	using Element = std::pair<double, T>;
+
+	// keep the log keys small enough to not lose precision of their random part
+	static constexpr double MaxExponent = 256.0;
+
+	static bool IsKeyLess(const Element& left, const Element& right)
+	{
+		return left.first < right.first;
+	}
+
+	void moveLandmark(double newLandmark)
+	{
+		// shifting all the keys by the same value doesn't change their order, so the heap stays valid
+		const double shift = mDecayRate * (newLandmark - mLandmark);
+		for (Element& element : mData)
+		{
+			element.first += shift;
+		}
+		mLandmark = newLandmark;
+	}
+
+private:
+	size_t mSampleSize;
+	double mDecayRate;
+	double mLandmark = 0.0;
+	bool mHasLandmark = false;
+	std::vector<Element> mData;
+	Rand mRand{std::random_device{}()};
+};
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+/**
+ * Uniformly samples up to sampleSize distinct values of a stream, regardless of how often each value repeats.
+ *
+ * Works like the priority-key sampling of ReservoirSamplerWeighted, but the key of an element is derived
+ * from the hash of its value instead of a random number, so all the copies of a value get the same key.
+ * The sample is the sampleSize distinct values with the smallest keys (bottom-k), which makes the result
+ * deterministic for a given hash function and independent of the order and multiplicity of the values.
+ *
+ * The hash should be well distributed over 64 bits, the result of the Hash is additionally mixed
+ * to make the identity hashes of integers usable. The sample is a uniform sample of distinct
+ * values as long as the hash function behaves like a random one, and samples from different
+ * streams taken with the same hash can be merged by keeping the smallest keys.
+ *
+ * Uses memory for sampleSize elements. Adding a value that can't get into the sample is O(1),
+ * a repeated value from the sample is O(log sampleSize), and only a new value that gets into the sample
+ * (expected O(sampleSize * log(distinctCount / sampleSize)) times per stream) is O(sampleSize).
+ */
+template<typename T, typename Hash = std::hash<T>>
+class ReservoirSamplerDistinct
+{
+public:
+	explicit ReservoirSamplerDistinct(size_t sampleSize, uint64_t seed = 0)
+		: mSampleSize(sampleSize)
+		, mSeedKey(mixBits(seed))
+	{
+		mData.reserve(sampleSize);
+	}
+
+	void sampleElement(const T& value)
+	{
+		sampleElementWithKey(getKey(value), value);
+	}
+
+	void sampleElement(T&& value)
+	{
+		const uint64_t key = getKey(value);
+		sampleElementWithKey(key, std::move(value));
+	}
+
+	/**
+	 * Returns false if the value can't affect the sample, such values can be skipped without calling sampleElement
+	 */
+	[[nodiscard]] bool willElementBeConsidered(const T& value) const
+	{
+		return willKeyBeConsidered(getKey(value));
+	}
+
+	[[nodiscard]] std::vector<T> getResult() const
+	{
+		std::vector<T> result;
+		result.reserve(mData.size());
+		for (const Element& element : mData)
+		{
+			result.push_back(element.second);
+		}
+		return result;
+	}
+
+	[[nodiscard]] size_t getResultSize() const
+	{
+		return mData.size();
+	}
+
+	[[nodiscard]] std::vector<T> consumeResult()
+	{
+		std::vector<T> result;
+		result.reserve(mData.size());
+		for (Element& element : mData)
+		{
+			result.push_back(std::move(element.second));
+		}
+		reset();
+		return result;
+	}
+
+	/**
+	 * Estimates the number of distinct values in the stream (KMV estimator).
+	 * Exact when the stream has fewer distinct values than the sample size.
+	 */
+	[[nodiscard]] double estimateDistinctCount() const
+	{
+		if (mData.size() < mSampleSize || mSampleSize < 2)
+		{
+			return static_cast<double>(mData.size());
+		}
+
+		// the largest of the k smallest keys normalized to [0, 1]
+		const double kthSmallestKey = (static_cast<double>(mData.back().first) + 1.0) / 18446744073709551616.0;
+		return static_cast<double>(mSampleSize - 1) / kthSmallestKey;
+	}
+
+	void reset()
+	{
+		mData.clear();
+	}
+
+private:
+	using Element = std::pair<uint64_t, T>;
+
+	// SplitMix64 step, turns any hash into a well distributed 64 bit key
+	static uint64_t mixBits(uint64_t bits)
+	{
+		uint64_t key = bits + 0x9E3779B97F4A7C15ull;
+		key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ull;
+		key = (key ^ (key >> 27)) * 0x94D049BB133111EBull;
+		return key ^ (key >> 31);
+	}
+
+	uint64_t getKey(const T& value) const
+	{
+		// the seed is mixed in together with the hash, so different seeds give unrelated orders of the values
+		return mixBits(mixBits(static_cast<uint64_t>(Hash{}(value))) ^ mSeedKey);
+	}
+
+	bool willKeyBeConsidered(uint64_t key) const
+	{
+		if (mData.size() < mSampleSize)
+		{
+			return true;
+		}
+		return mSampleSize > 0 && key <= mData.back().first;
+	}
+
+	template<typename Value>
+	void sampleElementWithKey(uint64_t key, Value&& value)
+	{
+		if (!willKeyBeConsidered(key))
+		{
+			return;
+		}
+
+		auto position = std::lower_bound(mData.begin(), mData.end(), key, [](const Element& element, uint64_t elementKey)
+		{
+			return element.first < elementKey;
+		});
+
+		// the value can already be in the sample, different values with the same key are very unlikely but possible
+		for (auto it = position; it != mData.end() && it->first == key; ++it)
+		{
+			if (it->second == value)
+			{
+				return;
+			}
+		}
+
+		if (mData.size() == mSampleSize)
+		{
+			if (position == std::prev(mData.end()))
+			{
+				// the new key goes right before the largest one, which is evicted anyway, so replace it in place
+				*position = Element(key, std::forward<Value>(value));
+				return;
+			}
+			mData.pop_back();
+		}
+		mData.emplace(position, key, std::forward<Value>(value));
+	}
+
+private:
+	size_t mSampleSize;
+	uint64_t mSeedKey;
+	// sorted by key, the back is the largest key in the sample
+	std::vector<Element> mData;
+};
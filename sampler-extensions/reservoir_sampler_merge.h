@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+/**
+ * Combines uniform samples taken from disjoint parts of a stream into one uniform sample of the whole stream.
+ *
+ * samples[i] should be a uniform sample without replacement of min(sampleSize, populationSizes[i]) elements
+ * taken from a part of the stream with populationSizes[i] elements (e.g. the result of a ReservoirSampler
+ * of the same sample size). The result is the same as if all the parts were fed to one sampler.
+ * The input samples are consumed.
+ */
+template<typename T, typename Rand>
+std::vector<T> mergeUniformSamples(std::vector<std::vector<T>>& samples, std::vector<uint64_t> populationSizes, size_t sampleSize, Rand& rand)
+{
+	uint64_t remainingPopulation = std::accumulate(populationSizes.begin(), populationSizes.end(), uint64_t{0});
+
+	std::vector<T> result;
+	result.reserve(static_cast<size_t>(std::min<uint64_t>(sampleSize, remainingPopulation)));
+
+	// draw elements of the whole population one by one without replacement,
+	// choosing the part first and then a not yet drawn element of the part's sample
+	while (result.size() < sampleSize && remainingPopulation > 0)
+	{
+		std::uniform_int_distribution<uint64_t> populationDistribution(0, remainingPopulation - 1);
+		uint64_t position = populationDistribution(rand);
+		size_t partIndex = 0;
+		while (position >= populationSizes[partIndex])
+		{
+			position -= populationSizes[partIndex];
+			++partIndex;
+		}
+
+		std::vector<T>& partSample = samples[partIndex];
+		std::uniform_int_distribution<size_t> elementDistribution(0, partSample.size() - 1);
+		const size_t elementIndex = elementDistribution(rand);
+		result.push_back(std::move(partSample[elementIndex]));
+		if (elementIndex + 1 != partSample.size())
+		{
+			partSample[elementIndex] = std::move(partSample.back());
+		}
+		partSample.pop_back();
+
+		--populationSizes[partIndex];
+		--remainingPopulation;
+	}
+
+	return result;
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#if __has_include(<version>)
+#include <version>
+#endif
+
+#if defined(__cpp_concepts) && defined(__cpp_lib_ranges)
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <random>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "reservoir-sampler/reservoir_sampler.h"
+
+#include "sampler-extensions/skip_ahead_sampling.h"
+
+/**
+ * A sampler that can consume elements of the given type one by one
+ */
+template<typename Sampler, typename T>
+concept ElementSampler = requires(Sampler& sampler, T&& value)
+{
+	sampler.sampleElement(std::forward<T>(value));
+};
+
+/**
+ * A sampler that can tell in advance how many elements it is going to skip and jump over them
+ */
+template<typename Sampler>
+concept SkipAheadSampler = requires(Sampler& sampler, size_t count)
+{
+	{ sampler.getNextSkippedElementsCount() } -> std::convertible_to<size_t>;
+	sampler.jumpAhead(count);
+};
+
+/**
+ * Feeds all the elements of the range to the sampler.
+ * Sized random access ranges are sampled with skip-ahead, so skipped elements are never accessed,
+ * other input ranges are iterated element by element.
+ */
+template<std::ranges::input_range Range, ElementSampler<std::ranges::range_reference_t<Range>> Sampler>
+void sampleRange(Range&& range, Sampler& sampler)
+{
+	if constexpr (std::ranges::random_access_range<Range> && std::ranges::sized_range<Range> && SkipAheadSampler<Sampler>)
+	{
+		const auto begin = std::ranges::begin(range);
+		// doesn't jump past the end, so the sampler can continue with another range
+		sampleElementsSkippingWith(sampler, static_cast<size_t>(std::ranges::size(range)), [&begin](size_t index) -> decltype(auto)
+		{
+			return begin[static_cast<std::ranges::range_difference_t<Range>>(index)];
+		});
+	}
+	else
+	{
+		for (auto&& element : range)
+		{
+			sampler.sampleElement(std::forward<decltype(element)>(element));
+		}
+	}
+}
+
+namespace views
+{
+	/**
+	 * Range adaptor closure returned by views::reservoir_sample(sampleSize[, rand]).
+	 * Piping a range into it returns a std::vector with a uniform random sample of the range elements.
+	 * Rand can be a reference type to use an external random engine, otherwise the closure owns its engine.
+	 * The engine advances with every sampled range, so one closure can be reused for several ranges,
+	 * but not from several threads at once.
+	 */
+	template<typename Rand>
+	class ReservoirSampleClosure
+	{
+	public:
+		ReservoirSampleClosure(size_t sampleSize, Rand rand)
+			: mSampleSize(sampleSize)
+			, mRand(std::forward<Rand>(rand))
+		{
+		}
+
+		template<std::ranges::input_range Range>
+		std::vector<std::ranges::range_value_t<Range>> operator()(Range&& range) const
+		{
+			std::remove_reference_t<Rand>& rand = mRand;
+			ReservoirSampler<std::ranges::range_value_t<Range>, std::remove_reference_t<Rand>&> sampler(mSampleSize, rand);
+			sampleRange(std::forward<Range>(range), sampler);
+			return sampler.consumeResult();
+		}
+
+		template<std::ranges::input_range Range>
+		friend std::vector<std::ranges::range_value_t<Range>> operator|(Range&& range, const ReservoirSampleClosure& closure)
+		{
+			return closure(std::forward<Range>(range));
+		}
+
+	private:
+		size_t mSampleSize;
+		// the piping operator is const, but sampling still needs to advance the engine
+		mutable std::conditional_t<std::is_reference_v<Rand>, std::reference_wrapper<std::remove_reference_t<Rand>>, Rand> mRand;
+	};
+
+	struct ReservoirSampleFn
+	{
+		template<std::uniform_random_bit_generator Rand>
+		ReservoirSampleClosure<Rand&> operator()(size_t sampleSize, Rand& rand) const
+		{
+			return ReservoirSampleClosure<Rand&>(sampleSize, rand);
+		}
+
+		ReservoirSampleClosure<std::mt19937> operator()(size_t sampleSize) const
+		{
+			return ReservoirSampleClosure<std::mt19937>(sampleSize, std::mt19937(std::random_device()()));
+		}
+
+		template<std::ranges::input_range Range, std::uniform_random_bit_generator Rand>
+		std::vector<std::ranges::range_value_t<Range>> operator()(Range&& range, size_t sampleSize, Rand& rand) const
+		{
+			return ReservoirSampleClosure<Rand&>(sampleSize, rand)(std::forward<Range>(range));
+		}
+
+		template<std::ranges::input_range Range>
+		std::vector<std::ranges::range_value_t<Range>> operator()(Range&& range, size_t sampleSize) const
+		{
+			return (*this)(sampleSize)(std::forward<Range>(range));
+		}
+	};
+
+	/**
+	 * Samples a range: `range | views::reservoir_sample(k, rand)` or `views::reservoir_sample(range, k, rand)`
+	 */
+	inline constexpr ReservoirSampleFn reservoir_sample;
+}
+
+#endif // __cpp_concepts && __cpp_lib_ranges
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "sampler-extensions/constexpr_random.h"
+
+/**
+ * Fixed-size uniform reservoir sampler (Algorithm R) that is usable in constant evaluation.
+ *
+ * Doesn't allocate, doesn't throw and doesn't rely on RTTI, all the storage is inline in the object.
+ * Compared to ReservoirSamplerStatic the elements should be default constructible
+ * (the storage is a std::array) and the generator should produce 64 bit numbers (SplitMix64 by default).
+ * Elements are taken without calling the generator until the sample is full, after that every element
+ * draws a bounded random index with bitmask rejection, which takes less than two calls to the generator on average.
+ *
+ * A default constructed sampler uses a default constructed generator (SplitMix64 seeded with 0),
+ * so all of them produce the same sample for the same stream. Pass a seeded generator to get different samples.
+ */
+template<typename T, size_t SampleSize, typename Rand = SplitMix64>
+class ReservoirSamplerStaticConstexpr
+{
+	static_assert(SampleSize > 0, "Sample size should be positive");
+	static_assert(std::is_default_constructible_v<T>, "Elements should be default constructible");
+
+public:
+	struct Result
+	{
+		const T* data;
+		size_t size;
+
+		constexpr const T* begin() const { return data; }
+		constexpr const T* end() const { return data + size; }
+	};
+
+public:
+	constexpr ReservoirSamplerStaticConstexpr() = default;
+
+	// doesn't take the sampler itself, so copies of non-const samplers use the copy constructor
+	template<typename RandArg>
+		requires (!std::is_same_v<std::remove_cvref_t<RandArg>, ReservoirSamplerStaticConstexpr>)
+	constexpr explicit ReservoirSamplerStaticConstexpr(RandArg&& rand)
+		: mRand(std::forward<RandArg>(rand))
+	{
+	}
+
+	constexpr void sampleElement(const T& value)
+	{
+		if (mProcessedElementsCount < SampleSize)
+		{
+			mData[static_cast<size_t>(mProcessedElementsCount)] = value;
+		}
+		else
+		{
+			const uint64_t index = getBoundedRandom(mRand, mProcessedElementsCount + 1);
+			if (index < SampleSize)
+			{
+				mData[static_cast<size_t>(index)] = value;
+			}
+		}
+		++mProcessedElementsCount;
+	}
+
+	[[nodiscard]] constexpr Result getResult() const
+	{
+		return Result{mData.data(), getResultSize()};
+	}
+
+	[[nodiscard]] constexpr size_t getResultSize() const
+	{
+		return mProcessedElementsCount < SampleSize ? static_cast<size_t>(mProcessedElementsCount) : SampleSize;
+	}
+
+	[[nodiscard]] constexpr uint64_t getProcessedElementsCount() const
+	{
+		return mProcessedElementsCount;
+	}
+
+	constexpr void reset()
+	{
+		mProcessedElementsCount = 0;
+	}
+
+private:
+	std::array<T, SampleSize> mData{};
+	uint64_t mProcessedElementsCount = 0;
+	// deterministic unless a generator is passed to the constructor
+	Rand mRand{};
+};
@@ -0,0 +1,254 @@
+#pragma once
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <random>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * Fixed-size reservoir sampler (Algorithm R) which keeps its whole state in a memory-mapped file.
+ *
+ * Every accepted element is written straight into the shared mapping, so the sample survives
+ * a crash of the process without any explicit serialization. A missing or empty file is created
+ * and initialized, opening a file written by a sampler with the same layout resumes the sampling.
+ * The writes are not synchronized, so another process should read the file only when
+ * no elements are being sampled into it.
+ *
+ * A file of a different size or with a different header is never modified, the sampler fails to open it instead.
+ * If the file couldn't be opened, sampling does nothing and the result is empty.
+ *
+ * Only trivially copyable types are supported, since the raw bytes are stored in the file.
+ */
+template<typename T, size_t SampleSize, typename Rand = std::mt19937>
+class ReservoirSamplerStaticMapped
+{
+	static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be stored in a mapped file");
+	static_assert(SampleSize > 0, "Sample size should be positive");
+
+public:
+	struct Header
+	{
+		uint64_t magic;
+		uint64_t elementSize;
+		uint64_t sampleSize;
+		// amount of elements the sampler has seen since the last reset
+		uint64_t processedElementsCount;
+		uint64_t filledElementsCount;
+		uint64_t reserved[3];
+	};
+	static_assert(sizeof(Header) == 64, "Header should occupy exactly one cache line");
+	static_assert(alignof(T) <= sizeof(Header), "Element alignment is not supported by the file layout");
+
+	static constexpr uint64_t Magic = 0x5253414D504C4552ull; // "RSAMPLER"
+	static constexpr size_t FileSize = sizeof(Header) + sizeof(T) * SampleSize;
+
+	struct Result
+	{
+		const T* data;
+		size_t size;
+
+		const T* begin() const { return data; }
+		const T* end() const { return data + size; }
+	};
+
+public:
+	explicit ReservoirSamplerStaticMapped(const char* filePath)
+	{
+		open(filePath);
+	}
+
+	template<typename RandArg>
+	ReservoirSamplerStaticMapped(const char* filePath, RandArg&& rand)
+		: mRand(std::forward<RandArg>(rand))
+	{
+		open(filePath);
+	}
+
+	ReservoirSamplerStaticMapped(const ReservoirSamplerStaticMapped&) = delete;
+	ReservoirSamplerStaticMapped& operator=(const ReservoirSamplerStaticMapped&) = delete;
+
+	ReservoirSamplerStaticMapped(ReservoirSamplerStaticMapped&& other) noexcept
+		: mFileDescriptor(std::exchange(other.mFileDescriptor, -1))
+		, mMapping(std::exchange(other.mMapping, nullptr))
+		, mRand(std::move(other.mRand))
+	{
+	}
+
+	ReservoirSamplerStaticMapped& operator=(ReservoirSamplerStaticMapped&&) = delete;
+
+	~ReservoirSamplerStaticMapped()
+	{
+		close();
+	}
+
+	/**
+	 * Returns false if the file could not be opened or mapped, or was not written by a sampler of the same layout
+	 */
+	[[nodiscard]] bool isOpen() const { return mMapping != nullptr; }
+
+	void sampleElement(const T& value)
+	{
+		if (!isOpen())
+		{
+			return;
+		}
+
+		Header& header = getHeader();
+		if (header.filledElementsCount < SampleSize)
+		{
+			getData()[header.filledElementsCount] = value;
+			++header.filledElementsCount;
+		}
+		else
+		{
+			std::uniform_int_distribution<uint64_t> distribution(0, header.processedElementsCount);
+			const uint64_t index = distribution(mRand);
+			if (index < SampleSize)
+			{
+				getData()[index] = value;
+			}
+		}
+		++header.processedElementsCount;
+	}
+
+	template<typename... Args>
+	void sampleElementEmplace(Args&&... arguments)
+	{
+		sampleElement(T(std::forward<Args>(arguments)...));
+	}
+
+	[[nodiscard]] Result getResult() const
+	{
+		if (!isOpen())
+		{
+			return Result{nullptr, 0};
+		}
+		return Result{getData(), getResultSize()};
+	}
+
+	[[nodiscard]] size_t getResultSize() const
+	{
+		return isOpen() ? static_cast<size_t>(getHeader().filledElementsCount) : 0;
+	}
+
+	[[nodiscard]] uint64_t getProcessedElementsCount() const
+	{
+		return isOpen() ? getHeader().processedElementsCount : 0;
+	}
+
+	void reset()
+	{
+		if (!isOpen())
+		{
+			return;
+		}
+
+		Header& header = getHeader();
+		header.filledElementsCount = 0;
+		header.processedElementsCount = 0;
+	}
+
+	/**
+	 * Blocks until the current state is written to the disk.
+	 * Not needed to survive a crash of the process, only to survive a crash of the OS.
+	 */
+	bool flush()
+	{
+		return isOpen() && ::msync(mMapping, FileSize, MS_SYNC) == 0;
+	}
+
+private:
+	void open(const char* filePath)
+	{
+		mFileDescriptor = ::open(filePath, O_RDWR | O_CREAT, 0644);
+		if (mFileDescriptor < 0)
+		{
+			return;
+		}
+
+		struct stat fileStat{};
+		if (::fstat(mFileDescriptor, &fileStat) != 0)
+		{
+			close();
+			return;
+		}
+
+		// only a new or empty file is initialized, any other file is left untouched
+		const bool isNewFile = fileStat.st_size == 0;
+		if (isNewFile && ::ftruncate(mFileDescriptor, static_cast<off_t>(FileSize)) != 0)
+		{
+			close();
+			return;
+		}
+
+		if (!isNewFile && static_cast<size_t>(fileStat.st_size) != FileSize)
+		{
+			close();
+			return;
+		}
+
+		void* mapping = ::mmap(nullptr, FileSize, PROT_READ | PROT_WRITE, MAP_SHARED, mFileDescriptor, 0);
+		if (mapping == MAP_FAILED)
+		{
+			close();
+			return;
+		}
+		mMapping = mapping;
+
+		Header& header = getHeader();
+		if (isNewFile)
+		{
+			header = Header{};
+			header.magic = Magic;
+			header.elementSize = sizeof(T);
+			header.sampleSize = SampleSize;
+			return;
+		}
+
+		const bool isLayoutCompatible = header.magic == Magic
+			&& header.elementSize == sizeof(T)
+			&& header.sampleSize == SampleSize
+			&& header.filledElementsCount <= SampleSize;
+
+		if (!isLayoutCompatible)
+		{
+			close();
+		}
+	}
+
+	void close()
+	{
+		if (mMapping != nullptr)
+		{
+			::munmap(mMapping, FileSize);
+			mMapping = nullptr;
+		}
+
+		if (mFileDescriptor >= 0)
+		{
+			::close(mFileDescriptor);
+			mFileDescriptor = -1;
+		}
+	}
+
+	Header& getHeader() { return *static_cast<Header*>(mMapping); }
+	const Header& getHeader() const { return *static_cast<const Header*>(mMapping); }
+	T* getData() { return std::launder(reinterpret_cast<T*>(static_cast<std::byte*>(mMapping) + sizeof(Header))); }
+	const T* getData() const { return std::launder(reinterpret_cast<const T*>(static_cast<const std::byte*>(mMapping) + sizeof(Header))); }
+
+private:
+	int mFileDescriptor = -1;
+	void* mMapping = nullptr;
+	Rand mRand{std::random_device{}()};
+};
+
+#endif // defined(__unix__) || defined(__APPLE__)
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "reservoir-sampler/reservoir_sampler.h"
+#include "reservoir-sampler/reservoir_sampler_static.h"
+
+/**
+ * Element of a sampler that remembers the position of the element in the stream
+ */
+template<typename T>
+struct StreamOrderedElement
+{
+	template<typename... Args>
+	explicit StreamOrderedElement(uint64_t position, Args&&... arguments)
+		: position(position)
+		, value(std::forward<Args>(arguments)...)
+	{
+	}
+
+	uint64_t position;
+	T value;
+};
+
+/**
+ * Returns the order of the elements sorted by their stream positions as a permutation of indices.
+ * Uses LSD radix sort for large amounts of elements, skipping the bytes that are the same for all positions.
+ */
+template<typename T>
+std::vector<size_t> getStreamOrder(const StreamOrderedElement<T>* elements, size_t size)
+{
+	// below this size a comparison sort is faster than doing several passes over the data
+	constexpr size_t RadixSortMinSize = 256;
+
+	std::vector<std::pair<uint64_t, size_t>> keys(size);
+	for (size_t i = 0; i < size; ++i)
+	{
+		keys[i] = {elements[i].position, i};
+	}
+
+	if (size < RadixSortMinSize)
+	{
+		std::sort(keys.begin(), keys.end());
+	}
+	else
+	{
+		uint64_t differentBits = 0;
+		for (const auto& key : keys)
+		{
+			differentBits |= key.first ^ keys[0].first;
+		}
+
+		std::vector<std::pair<uint64_t, size_t>> buffer(size);
+		for (unsigned shift = 0; shift < 64; shift += 8)
+		{
+			if (((differentBits >> shift) & 0xFF) == 0)
+			{
+				continue;
+			}
+
+			std::array<size_t, 257> offsets{};
+			for (const auto& key : keys)
+			{
+				++offsets[((key.first >> shift) & 0xFF) + 1];
+			}
+			for (size_t digit = 1; digit < offsets.size(); ++digit)
+			{
+				offsets[digit] += offsets[digit - 1];
+			}
+			for (const auto& key : keys)
+			{
+				buffer[offsets[(key.first >> shift) & 0xFF]++] = key;
+			}
+			std::swap(keys, buffer);
+		}
+	}
+
+	std::vector<size_t> order(size);
+	for (size_t i = 0; i < size; ++i)
+	{
+		order[i] = keys[i].second;
+	}
+	return order;
+}
+
+/**
+ * Adapter for a uniform sampler (ReservoirSampler or ReservoirSamplerStatic of StreamOrderedElement<T>)
+ * that tracks stream positions of the sampled elements and returns the result in the stream order.
+ * Use through ReservoirSamplerStreamOrdered and ReservoirSamplerStaticStreamOrdered aliases.
+ */
+template<typename T, typename Sampler>
+class StreamOrderedSampler
+{
+public:
+	// arguments are forwarded to the underlying sampler, copies and moves use the implicit constructors
+	template<typename... SamplerArgs, typename = std::enable_if_t<!(std::is_same_v<std::decay_t<SamplerArgs>, StreamOrderedSampler> || ...)>>
+	explicit StreamOrderedSampler(SamplerArgs&&... samplerArguments)
+		: mSampler(std::forward<SamplerArgs>(samplerArguments)...)
+	{
+	}
+
+	void sampleElement(const T& value)
+	{
+		sampleElementEmplace(value);
+	}
+
+	void sampleElement(T&& value)
+	{
+		sampleElementEmplace(std::move(value));
+	}
+
+	template<typename... Args>
+	void sampleElementEmplace(Args&&... arguments)
+	{
+		mSampler.sampleElementEmplace(mNextPosition, std::forward<Args>(arguments)...);
+		++mNextPosition;
+	}
+
+	bool willNextElementBeConsidered()
+	{
+		return mSampler.willNextElementBeConsidered();
+	}
+
+	void skipNextElement()
+	{
+		mSampler.skipNextElement();
+		++mNextPosition;
+	}
+
+	size_t getNextSkippedElementsCount()
+	{
+		return mSampler.getNextSkippedElementsCount();
+	}
+
+	void jumpAhead(size_t elementsCount)
+	{
+		mSampler.jumpAhead(elementsCount);
+		mNextPosition += elementsCount;
+	}
+
+	/**
+	 * Returns the sampled elements with their positions in the order they are stored in the sampler
+	 */
+	[[nodiscard]] auto getUnorderedResult() const
+	{
+		return mSampler.getResult();
+	}
+
+	[[nodiscard]] size_t getResultSize() const
+	{
+		return mSampler.getResultSize();
+	}
+
+	/**
+	 * Moves the sampled elements out in the order they appeared in the stream and resets the sampler.
+	 * The order is found on indices, so the elements are not moved while sorting, but besides the moves
+	 * made by consumeResult of the underlying sampler every element is moved once more into the result.
+	 */
+	[[nodiscard]] std::vector<T> consumeResult()
+	{
+		std::vector<StreamOrderedElement<T>> elements = mSampler.consumeResult();
+		const std::vector<size_t> order = getStreamOrder(elements.data(), elements.size());
+
+		std::vector<T> result;
+		result.reserve(elements.size());
+		for (size_t index : order)
+		{
+			result.push_back(std::move(elements[index].value));
+		}
+
+		mNextPosition = 0;
+		return result;
+	}
+
+	void reset()
+	{
+		mSampler.reset();
+		mNextPosition = 0;
+	}
+
+private:
+	Sampler mSampler;
+	uint64_t mNextPosition = 0;
+};
+
+template<typename T, typename Rand = std::mt19937>
+using ReservoirSamplerStreamOrdered = StreamOrderedSampler<T, ReservoirSampler<StreamOrderedElement<T>, Rand>>;
+
+template<typename T, size_t SampleSize, typename Rand = std::mt19937>
+using ReservoirSamplerStaticStreamOrdered = StreamOrderedSampler<T, ReservoirSamplerStatic<StreamOrderedElement<T>, SampleSize, Rand>>;
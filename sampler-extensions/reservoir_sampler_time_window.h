@@ -0,0 +1,174 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+/**
+ * Uniformly samples up to sampleSize elements (without replacement) from the elements
+ * whose timestamps are within the last windowDuration.
+ *
+ * Every element gets a random priority and the sample is the sampleSize elements with the highest
+ * priorities in the window. An element can be in the sample only while fewer than sampleSize newer
+ * elements have a higher priority, so only such elements are stored (expected O(sampleSize * log(n / sampleSize))
+ * elements for n elements in the window).
+ *
+ * Complexity, for m stored elements: adding an element walks over every stored element with a lower priority,
+ * so a single call can take O(m), but a stored element is walked over at most sampleSize times before it is dropped,
+ * so adding takes amortized O(sampleSize + log(m)) time. This is not the O(log(sampleSize)) update of
+ * a heap of the top priorities, which can't tell which elements to restore once the top ones expire.
+ * Every added element allocates one list node and one map node. Removing an expired element
+ * takes O(log(m)), getResultAt() takes O(sampleSize) after the expired elements are removed.
+ *
+ * Timestamps should not decrease. Expired elements are removed lazily when elements are added or the result is requested.
+ */
+template<typename T, typename Clock = std::chrono::steady_clock, typename Rand = std::mt19937>
+class ReservoirSamplerTimeWindow
+{
+public:
+	using TimePoint = typename Clock::time_point;
+	using Duration = typename Clock::duration;
+
+public:
+	ReservoirSamplerTimeWindow(size_t sampleSize, Duration windowDuration)
+		: mSampleSize(sampleSize)
+		, mWindowDuration(windowDuration)
+	{
+	}
+
+	template<typename RandArg>
+	ReservoirSamplerTimeWindow(size_t sampleSize, Duration windowDuration, RandArg&& rand)
+		: mSampleSize(sampleSize)
+		, mWindowDuration(windowDuration)
+		, mRand(std::forward<RandArg>(rand))
+	{
+	}
+
+	// the map refers to the list nodes, copying would need to rebuild it
+	ReservoirSamplerTimeWindow(const ReservoirSamplerTimeWindow&) = delete;
+	ReservoirSamplerTimeWindow& operator=(const ReservoirSamplerTimeWindow&) = delete;
+	ReservoirSamplerTimeWindow(ReservoirSamplerTimeWindow&&) noexcept = default;
+	ReservoirSamplerTimeWindow& operator=(ReservoirSamplerTimeWindow&&) noexcept = default;
+
+	void sampleElement(const T& value)
+	{
+		sampleElementEmplaceAt(Clock::now(), value);
+	}
+
+	void sampleElement(T&& value)
+	{
+		sampleElementEmplaceAt(Clock::now(), std::move(value));
+	}
+
+	void sampleElementAt(TimePoint timestamp, const T& value)
+	{
+		sampleElementEmplaceAt(timestamp, value);
+	}
+
+	void sampleElementAt(TimePoint timestamp, T&& value)
+	{
+		sampleElementEmplaceAt(timestamp, std::move(value));
+	}
+
+	template<typename... Args>
+	void sampleElementEmplaceAt(TimePoint timestamp, Args&&... arguments)
+	{
+		removeExpiredElements(timestamp);
+
+		if (mSampleSize == 0)
+		{
+			return;
+		}
+
+		std::uniform_int_distribution<uint64_t> distribution;
+		const PriorityKey key{distribution(mRand), mNextSequenceNumber++};
+
+		// all stored elements with lower priority are dominated by the new one
+		for (auto it = mElementsByPriority.begin(); it != mElementsByPriority.end() && it->first < key;)
+		{
+			typename std::list<Node>::iterator node = it->second;
+			++node->dominatingElementsCount;
+			if (node->dominatingElementsCount >= mSampleSize)
+			{
+				mElementsByTime.erase(node);
+				it = mElementsByPriority.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+
+		mElementsByTime.push_back(Node{key, timestamp, 0, T(std::forward<Args>(arguments)...)});
+		mElementsByPriority.emplace(key, std::prev(mElementsByTime.end()));
+	}
+
+	/**
+	 * Returns a uniform sample of the elements within the window ending at the given time
+	 */
+	[[nodiscard]] std::vector<T> getResultAt(TimePoint now)
+	{
+		removeExpiredElements(now);
+
+		std::vector<T> result;
+		result.reserve(std::min(mSampleSize, mElementsByPriority.size()));
+		for (auto it = mElementsByPriority.rbegin(); it != mElementsByPriority.rend() && result.size() < mSampleSize; ++it)
+		{
+			result.push_back(it->second->value);
+		}
+		return result;
+	}
+
+	[[nodiscard]] std::vector<T> getResult()
+	{
+		return getResultAt(Clock::now());
+	}
+
+	/**
+	 * Amount of elements that are currently stored, not all of them are part of the sample
+	 */
+	[[nodiscard]] size_t getStoredElementsCount() const
+	{
+		return mElementsByTime.size();
+	}
+
+	void reset()
+	{
+		mElementsByPriority.clear();
+		mElementsByTime.clear();
+	}
+
+private:
+	// random priority, ties are resolved by the arrival order
+	using PriorityKey = std::pair<uint64_t, uint64_t>;
+
+	struct Node
+	{
+		PriorityKey key;
+		TimePoint timestamp;
+		size_t dominatingElementsCount;
+		T value;
+	};
+
+	void removeExpiredElements(TimePoint now)
+	{
+		while (!mElementsByTime.empty() && mElementsByTime.front().timestamp + mWindowDuration <= now)
+		{
+			mElementsByPriority.erase(mElementsByTime.front().key);
+			mElementsByTime.pop_front();
+		}
+	}
+
+private:
+	size_t mSampleSize;
+	Duration mWindowDuration;
+	uint64_t mNextSequenceNumber = 0;
+	std::list<Node> mElementsByTime;
+	std::map<PriorityKey, typename std::list<Node>::iterator> mElementsByPriority;
+	Rand mRand{std::random_device{}()};
+};
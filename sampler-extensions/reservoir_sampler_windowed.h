@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+/**
+ * Uniformly samples up to sampleSize elements (without replacement) from the last windowSize elements of a stream.
+ *
+ * The stream is split into buckets of windowSize elements and every bucket is sampled with a regular reservoir.
+ * The window always covers a suffix of the previous bucket and a prefix of the current one,
+ * the unexpired elements of the previous bucket's sample are combined with a random subset of the current
+ * bucket's sample, which gives exactly the distribution of a uniform sample of the window.
+ *
+ * Uses memory for 2 * sampleSize elements, adding an element takes amortized O(1), getting the result O(sampleSize).
+ */
+template<typename T, typename Rand = std::mt19937>
+class ReservoirSamplerWindowed
+{
+public:
+	ReservoirSamplerWindowed(size_t sampleSize, uint64_t windowSize)
+		: mSampleSize(sampleSize)
+		, mWindowSize(windowSize)
+	{
+		assert(windowSize > 0);
+	}
+
+	template<typename RandArg>
+	ReservoirSamplerWindowed(size_t sampleSize, uint64_t windowSize, RandArg&& rand)
+		: mSampleSize(sampleSize)
+		, mWindowSize(windowSize)
+		, mRand(std::forward<RandArg>(rand))
+	{
+		assert(windowSize > 0);
+	}
+
+	void sampleElement(const T& value)
+	{
+		sampleElementEmplace(value);
+	}
+
+	void sampleElement(T&& value)
+	{
+		sampleElementEmplace(std::move(value));
+	}
+
+	template<typename... Args>
+	void sampleElementEmplace(Args&&... arguments)
+	{
+		if (mCurrentBucketElementsCount == mWindowSize)
+		{
+			startNewBucket();
+		}
+
+		if (mCurrentBucket.size() < mSampleSize)
+		{
+			mCurrentBucket.emplace_back(std::piecewise_construct, std::forward_as_tuple(mProcessedElementsCount), std::forward_as_tuple(std::forward<Args>(arguments)...));
+		}
+		else
+		{
+			std::uniform_int_distribution<uint64_t> distribution(0, mCurrentBucketElementsCount);
+			const uint64_t index = distribution(mRand);
+			if (index < mSampleSize)
+			{
+				mCurrentBucket[static_cast<size_t>(index)] = Element(std::piecewise_construct, std::forward_as_tuple(mProcessedElementsCount), std::forward_as_tuple(std::forward<Args>(arguments)...));
+			}
+		}
+
+		++mCurrentBucketElementsCount;
+		++mProcessedElementsCount;
+	}
+
+	/**
+	 * Returns a uniform sample of the current window.
+	 * Draws random numbers, so two calls without new elements in between may return different samples.
+	 */
+	[[nodiscard]] std::vector<T> getResult()
+	{
+		removeExpiredElements();
+
+		std::vector<T> result;
+		result.reserve(std::min(mSampleSize, mPreviousBucket.size() + mCurrentBucket.size()));
+		for (const Element& element : mPreviousBucket)
+		{
+			result.push_back(element.second);
+		}
+
+		// the rest of the sample is a random subset of the current bucket's sample
+		const size_t currentBucketTakenCount = std::min(mSampleSize - result.size(), mCurrentBucket.size());
+		for (size_t i = 0; i < currentBucketTakenCount; ++i)
+		{
+			std::uniform_int_distribution<size_t> distribution(i, mCurrentBucket.size() - 1);
+			std::swap(mCurrentBucket[i], mCurrentBucket[distribution(mRand)]);
+			result.push_back(mCurrentBucket[i].second);
+		}
+
+		return result;
+	}
+
+	[[nodiscard]] uint64_t getProcessedElementsCount() const
+	{
+		return mProcessedElementsCount;
+	}
+
+	void reset()
+	{
+		mPreviousBucket.clear();
+		mCurrentBucket.clear();
+		mCurrentBucketElementsCount = 0;
+		mProcessedElementsCount = 0;
+	}
+
+private:
+	using Element = std::pair<uint64_t, T>;
+
+	void startNewBucket()
+	{
+		std::swap(mPreviousBucket, mCurrentBucket);
+		mCurrentBucket.clear();
+		mCurrentBucketElementsCount = 0;
+	}
+
+	void removeExpiredElements()
+	{
+		if (mProcessedElementsCount <= mWindowSize)
+		{
+			return;
+		}
+
+		const uint64_t firstPositionInWindow = mProcessedElementsCount - mWindowSize;
+		mPreviousBucket.erase(
+			std::remove_if(mPreviousBucket.begin(), mPreviousBucket.end(), [firstPositionInWindow](const Element& element)
+			{
+				return element.first < firstPositionInWindow;
+			}),
+			mPreviousBucket.end()
+		);
+	}
+
+private:
+	size_t mSampleSize;
+	uint64_t mWindowSize;
+	uint64_t mProcessedElementsCount = 0;
+	uint64_t mCurrentBucketElementsCount = 0;
+	std::vector<Element> mPreviousBucket;
+	std::vector<Element> mCurrentBucket;
+	Rand mRand{std::random_device{}()};
+};
@@ -0,0 +1,383 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Opt-in instrumentation of samplers.
+ *
+ * InstrumentedSampler<Sampler> forwards all calls to the wrapped sampler and collects per-sampler counts.
+ * Counting is compiled out unless RESERVOIR_SAMPLER_INSTRUMENTATION is defined to a non-zero value,
+ * so production code can keep the wrapper in place and enable it only in diagnostic builds.
+ * Copies, moves and constructions are counted for elements of type CountedElement<T>,
+ * random draws are counted for generators of type CountingRand<Rand>.
+ */
+
+#ifndef RESERVOIR_SAMPLER_INSTRUMENTATION
+#define RESERVOIR_SAMPLER_INSTRUMENTATION 0
+#endif
+
+constexpr bool IsSamplerInstrumentationEnabled = RESERVOIR_SAMPLER_INSTRUMENTATION != 0;
+
+struct SamplerInstrumentationStats
+{
+	// elements passed to the sampler, including the skipped ones
+	uint64_t offeredElementsCount = 0;
+	uint64_t skippedElementsCount = 0;
+	// elements that were put to the reservoir, including replacements
+	// (samplers that can't tell in advance if an element is considered, e.g. ReservoirSamplerLinear,
+	// count only the elements that grew the sample, and neither skips nor replacements)
+	uint64_t storedElementsCount = 0;
+	uint64_t replacedElementsCount = 0;
+	uint64_t elementConstructionsCount = 0;
+	uint64_t elementCopiesCount = 0;
+	uint64_t elementMovesCount = 0;
+	uint64_t randomDrawsCount = 0;
+
+	SamplerInstrumentationStats& operator+=(const SamplerInstrumentationStats& other)
+	{
+		offeredElementsCount += other.offeredElementsCount;
+		skippedElementsCount += other.skippedElementsCount;
+		storedElementsCount += other.storedElementsCount;
+		replacedElementsCount += other.replacedElementsCount;
+		elementConstructionsCount += other.elementConstructionsCount;
+		elementCopiesCount += other.elementCopiesCount;
+		elementMovesCount += other.elementMovesCount;
+		randomDrawsCount += other.randomDrawsCount;
+		return *this;
+	}
+};
+
+namespace SamplerInstrumentationInternal
+{
+	// stats of the sampler that is currently executing a call on this thread
+	inline thread_local SamplerInstrumentationStats* gCurrentStats = nullptr;
+
+	class CurrentStatsScope
+	{
+	public:
+		explicit CurrentStatsScope(SamplerInstrumentationStats* stats)
+			: mPreviousStats(std::exchange(gCurrentStats, stats))
+		{
+		}
+
+		~CurrentStatsScope()
+		{
+			gCurrentStats = mPreviousStats;
+		}
+
+		CurrentStatsScope(const CurrentStatsScope&) = delete;
+		CurrentStatsScope& operator=(const CurrentStatsScope&) = delete;
+
+	private:
+		SamplerInstrumentationStats* mPreviousStats;
+	};
+
+	class NoStatsScope
+	{
+	};
+
+	template<typename T, typename... Args>
+	constexpr bool IsCopyOrMove = sizeof...(Args) == 1 && (std::is_same_v<std::decay_t<Args>, T> && ...);
+
+	template<typename Func>
+	void updateCurrentStats(Func&& func)
+	{
+		if (gCurrentStats != nullptr)
+		{
+			func(*gCurrentStats);
+		}
+	}
+}
+
+/**
+ * Element wrapper that reports its constructions, copies and moves to the sampler that is handling it
+ */
+template<typename T>
+class CountedElement
+{
+public:
+	template<typename... Args, typename = std::enable_if_t<std::is_constructible_v<T, Args&&...> && !SamplerInstrumentationInternal::IsCopyOrMove<CountedElement<T>, Args...>>>
+	CountedElement(Args&&... arguments)
+		: value(std::forward<Args>(arguments)...)
+	{
+		SamplerInstrumentationInternal::updateCurrentStats([](SamplerInstrumentationStats& stats){ ++stats.elementConstructionsCount; });
+	}
+
+	CountedElement(const CountedElement& other)
+		: value(other.value)
+	{
+		SamplerInstrumentationInternal::updateCurrentStats([](SamplerInstrumentationStats& stats){ ++stats.elementCopiesCount; });
+	}
+
+	CountedElement(CountedElement&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+		: value(std::move(other.value))
+	{
+		SamplerInstrumentationInternal::updateCurrentStats([](SamplerInstrumentationStats& stats){ ++stats.elementMovesCount; });
+	}
+
+	CountedElement& operator=(const CountedElement& other)
+	{
+		value = other.value;
+		SamplerInstrumentationInternal::updateCurrentStats([](SamplerInstrumentationStats& stats){ ++stats.elementCopiesCount; });
+		return *this;
+	}
+
+	CountedElement& operator=(CountedElement&& other) noexcept(std::is_nothrow_move_assignable_v<T>)
+	{
+		value = std::move(other.value);
+		SamplerInstrumentationInternal::updateCurrentStats([](SamplerInstrumentationStats& stats){ ++stats.elementMovesCount; });
+		return *this;
+	}
+
+	~CountedElement() = default;
+
+	T value;
+};
+
+/**
+ * Generator wrapper that reports the amount of random numbers drawn by the sampler that uses it.
+ * Rand can be a reference type to wrap an external generator.
+ */
+template<typename Rand>
+class CountingRand
+{
+public:
+	using result_type = typename std::decay_t<Rand>::result_type;
+
+public:
+	template<typename... Args>
+	explicit CountingRand(Args&&... arguments)
+		: mRand(std::forward<Args>(arguments)...)
+	{
+	}
+
+	static constexpr result_type min() { return std::decay_t<Rand>::min(); }
+	static constexpr result_type max() { return std::decay_t<Rand>::max(); }
+
+	result_type operator()()
+	{
+		SamplerInstrumentationInternal::updateCurrentStats([](SamplerInstrumentationStats& stats){ ++stats.randomDrawsCount; });
+		return mRand();
+	}
+
+private:
+	Rand mRand;
+};
+
+/**
+ * Forwards calls to the sampler and counts what happens with the elements when Enabled is true
+ */
+template<typename Sampler, bool Enabled = IsSamplerInstrumentationEnabled>
+class InstrumentedSampler
+{
+public:
+	// arguments are forwarded to the underlying sampler, copies and moves use the implicit constructors
+	template<typename... Args, typename = std::enable_if_t<!(std::is_same_v<std::decay_t<Args>, InstrumentedSampler> || ...)>>
+	explicit InstrumentedSampler(Args&&... arguments)
+		: mSampler(std::forward<Args>(arguments)...)
+	{
+	}
+
+	template<typename... Args>
+	void sampleElement(Args&&... arguments)
+	{
+		addElement([this](auto&&... forwardedArguments){ mSampler.sampleElement(std::forward<decltype(forwardedArguments)>(forwardedArguments)...); }, std::forward<Args>(arguments)...);
+	}
+
+	template<typename... Args>
+	void sampleElementEmplace(Args&&... arguments)
+	{
+		addElement([this](auto&&... forwardedArguments){ mSampler.sampleElementEmplace(std::forward<decltype(forwardedArguments)>(forwardedArguments)...); }, std::forward<Args>(arguments)...);
+	}
+
+	template<typename... Args>
+	bool willNextElementBeConsidered(Args&&... arguments)
+	{
+		[[maybe_unused]] const auto scope = makeScope();
+		return mSampler.willNextElementBeConsidered(std::forward<Args>(arguments)...);
+	}
+
+	template<typename... Args>
+	void skipNextElement(Args&&... arguments)
+	{
+		[[maybe_unused]] const auto scope = makeScope();
+		mSampler.skipNextElement(std::forward<Args>(arguments)...);
+		updateStats([](SamplerInstrumentationStats& stats){ ++stats.offeredElementsCount; ++stats.skippedElementsCount; });
+	}
+
+	size_t getNextSkippedElementsCount()
+	{
+		[[maybe_unused]] const auto scope = makeScope();
+		return mSampler.getNextSkippedElementsCount();
+	}
+
+	void jumpAhead(size_t elementsCount)
+	{
+		[[maybe_unused]] const auto scope = makeScope();
+		mSampler.jumpAhead(elementsCount);
+		updateStats([elementsCount](SamplerInstrumentationStats& stats){ stats.offeredElementsCount += elementsCount; stats.skippedElementsCount += elementsCount; });
+	}
+
+	decltype(auto) getResult() const { return mSampler.getResult(); }
+	size_t getResultSize() const { return mSampler.getResultSize(); }
+
+	decltype(auto) consumeResult()
+	{
+		[[maybe_unused]] const auto scope = makeScope();
+		return mSampler.consumeResult();
+	}
+
+	template<typename OutputIt>
+	void consumeResultTo(OutputIt output)
+	{
+		[[maybe_unused]] const auto scope = makeScope();
+		mSampler.consumeResultTo(output);
+	}
+
+	void reset()
+	{
+		[[maybe_unused]] const auto scope = makeScope();
+		mSampler.reset();
+	}
+
+	void allocateData()
+	{
+		[[maybe_unused]] const auto scope = makeScope();
+		mSampler.allocateData();
+	}
+
+	/**
+	 * Returns the counts collected since construction or the last resetStats(), all zeros if instrumentation is disabled
+	 */
+	const SamplerInstrumentationStats& getStats() const { return mStats; }
+	void resetStats() { mStats = {}; }
+
+	Sampler& getSampler() { return mSampler; }
+	const Sampler& getSampler() const { return mSampler; }
+
+private:
+	template<typename AddFunc, typename... Args>
+	void addElement(AddFunc&& add, Args&&... arguments)
+	{
+		if constexpr (!Enabled)
+		{
+			add(std::forward<Args>(arguments)...);
+		}
+		else if constexpr (canTellIfNextElementIsConsidered<Args...>())
+		{
+			const SamplerInstrumentationInternal::CurrentStatsScope scope(&mStats);
+			const bool isConsidered = isNextElementConsidered(arguments...);
+			const size_t storedCountBefore = getStoredElementsCount();
+
+			add(std::forward<Args>(arguments)...);
+
+			++mStats.offeredElementsCount;
+			if (!isConsidered)
+			{
+				++mStats.skippedElementsCount;
+				return;
+			}
+
+			++mStats.storedElementsCount;
+			// the size didn't grow, so an element was replaced
+			if (storedCountBefore == getStoredElementsCount())
+			{
+				++mStats.replacedElementsCount;
+			}
+		}
+		else
+		{
+			// e.g. ReservoirSamplerLinear, only the elements that grow the sample can be told apart
+			const SamplerInstrumentationInternal::CurrentStatsScope scope(&mStats);
+			const size_t storedCountBefore = getStoredElementsCount();
+
+			add(std::forward<Args>(arguments)...);
+
+			++mStats.offeredElementsCount;
+			if (storedCountBefore != getStoredElementsCount())
+			{
+				++mStats.storedElementsCount;
+			}
+		}
+	}
+
+	template<typename... Args>
+	static constexpr bool canTellIfNextElementIsConsidered()
+	{
+		if constexpr (requires(Sampler& sampler) { sampler.willNextElementBeConsidered(); })
+		{
+			return true;
+		}
+		else
+		{
+			return canTellIfNextWeightedElementIsConsidered<Args...>();
+		}
+	}
+
+	template<typename Weight, typename... Args>
+	static constexpr bool canTellIfNextWeightedElementIsConsidered()
+	{
+		return requires(Sampler& sampler, const Weight& weight) { sampler.willNextElementBeConsidered(weight); };
+	}
+
+	template<typename... Args>
+	bool isNextElementConsidered(const Args&... arguments)
+	{
+		if constexpr (requires(Sampler& sampler) { sampler.willNextElementBeConsidered(); })
+		{
+			return mSampler.willNextElementBeConsidered();
+		}
+		else
+		{
+			return isNextWeightedElementConsidered(arguments...);
+		}
+	}
+
+	template<typename Weight, typename... Args>
+	bool isNextWeightedElementConsidered(const Weight& weight, const Args&...)
+	{
+		// weighted samplers take the weight as the first argument
+		return mSampler.willNextElementBeConsidered(weight);
+	}
+
+	size_t getStoredElementsCount() const
+	{
+		if constexpr (requires(const Sampler& sampler) { sampler.getResultSize(); })
+		{
+			return mSampler.getResultSize();
+		}
+		else
+		{
+			// samplers of one element
+			return mSampler.getResult().has_value() ? 1 : 0;
+		}
+	}
+
+	auto makeScope()
+	{
+		if constexpr (Enabled)
+		{
+			return SamplerInstrumentationInternal::CurrentStatsScope(&mStats);
+		}
+		else
+		{
+			return SamplerInstrumentationInternal::NoStatsScope();
+		}
+	}
+
+	template<typename Func>
+	void updateStats(Func&& func)
+	{
+		if constexpr (Enabled)
+		{
+			func(mStats);
+		}
+	}
+
+private:
+	Sampler mSampler;
+	SamplerInstrumentationStats mStats;
+};
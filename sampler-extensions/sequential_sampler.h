@@ -0,0 +1,197 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+/**
+ * Selects sampleSize distinct indices out of [0, populationSize) in increasing order,
+ * when the size of the population is known in advance (Vitter's Algorithm D).
+ *
+ * Instead of deciding for every element, it generates the amount of elements to skip before
+ * the next selected one, so it takes O(sampleSize) expected time independently of populationSize
+ * and allows to read only the selected records.
+ * When the sample is a large part of the remaining population it switches to the simpler Algorithm A.
+ */
+template<typename Rand = std::mt19937>
+class SequentialSampler
+{
+public:
+	SequentialSampler(uint64_t populationSize, uint64_t sampleSize)
+		: mRemainingPopulationSize(static_cast<double>(populationSize))
+		, mRemainingSampleSize(std::min(sampleSize, populationSize))
+	{
+		initVprime();
+	}
+
+	template<typename RandArg>
+	SequentialSampler(uint64_t populationSize, uint64_t sampleSize, RandArg&& rand)
+		: mRemainingPopulationSize(static_cast<double>(populationSize))
+		, mRemainingSampleSize(std::min(sampleSize, populationSize))
+		, mRand(std::forward<RandArg>(rand))
+	{
+		initVprime();
+	}
+
+	[[nodiscard]] bool hasNext() const
+	{
+		return mRemainingSampleSize > 0;
+	}
+
+	/**
+	 * Returns the next selected index, should be called only when hasNext() returns true
+	 */
+	uint64_t next()
+	{
+		const uint64_t skippedCount = (mRemainingSampleSize > 1 && !mUseMethodA) ? getNextSkipMethodD() : getNextSkipMethodA();
+
+		const uint64_t index = mNextIndex + skippedCount;
+		mNextIndex = index + 1;
+		mRemainingPopulationSize -= static_cast<double>(skippedCount + 1);
+		--mRemainingSampleSize;
+		return index;
+	}
+
+private:
+	// Algorithm D is used while sampleSize * AlphaInverse < populationSize
+	static constexpr double AlphaInverse = 13.0;
+
+	double generateUniform()
+	{
+		// (0, 1], zero would break the logarithms below
+		return 1.0 - std::generate_canonical<double, 53>(mRand);
+	}
+
+	void initVprime()
+	{
+		mUseMethodA = static_cast<double>(mRemainingSampleSize) * AlphaInverse >= mRemainingPopulationSize;
+		if (!mUseMethodA && mRemainingSampleSize > 0)
+		{
+			mVprime = std::exp(std::log(generateUniform()) / static_cast<double>(mRemainingSampleSize));
+		}
+	}
+
+	uint64_t getNextSkipMethodA()
+	{
+		mUseMethodA = true;
+		const double n = static_cast<double>(mRemainingSampleSize);
+		double remainingPopulation = mRemainingPopulationSize;
+
+		if (mRemainingSampleSize == 1)
+		{
+			const double skip = std::floor(remainingPopulation * generateUniform());
+			return static_cast<uint64_t>(std::min(skip, remainingPopulation - 1.0));
+		}
+
+		double top = remainingPopulation - n;
+		const double v = generateUniform();
+		uint64_t skip = 0;
+		double quotient = top / remainingPopulation;
+		while (quotient > v)
+		{
+			++skip;
+			--top;
+			--remainingPopulation;
+			quotient = quotient * top / remainingPopulation;
+		}
+		return skip;
+	}
+
+	uint64_t getNextSkipMethodD()
+	{
+		const double N = mRemainingPopulationSize;
+		const double n = static_cast<double>(mRemainingSampleSize);
+		const double nInverse = 1.0 / n;
+		const double nMin1Inverse = 1.0 / (n - 1.0);
+		const double qu1 = N - n + 1.0;
+
+		double skip = 0.0;
+		while (true)
+		{
+			double x = 0.0;
+			while (true)
+			{
+				x = N * (1.0 - mVprime);
+				skip = std::floor(x);
+				if (skip < qu1)
+				{
+					break;
+				}
+				mVprime = std::exp(std::log(generateUniform()) * nInverse);
+			}
+
+			const double u = generateUniform();
+			const double y1 = std::exp(std::log(u * N / qu1) * nMin1Inverse);
+			mVprime = y1 * (1.0 - x / N) * (qu1 / (qu1 - skip));
+			if (mVprime <= 1.0)
+			{
+				// accepted by the cheap test, mVprime is reused for the next skip
+				break;
+			}
+
+			double y2 = 1.0;
+			double top = N - 1.0;
+			double bottom;
+			double limit;
+			if (n - 1.0 > skip)
+			{
+				bottom = N - n;
+				limit = N - skip;
+			}
+			else
+			{
+				bottom = N - skip - 1.0;
+				limit = qu1;
+			}
+
+			for (double t = N - 1.0; t >= limit; --t)
+			{
+				y2 = (y2 * top) / bottom;
+				--top;
+				--bottom;
+			}
+
+			if (N / (N - x) >= y1 * std::exp(std::log(y2) * nMin1Inverse))
+			{
+				mVprime = std::exp(std::log(generateUniform()) * nMin1Inverse);
+				break;
+			}
+			mVprime = std::exp(std::log(generateUniform()) * nInverse);
+		}
+
+		// switch to Algorithm A once the sample becomes a large part of the remaining population
+		const double nextPopulation = N - skip - 1.0;
+		if ((n - 1.0) * AlphaInverse >= nextPopulation)
+		{
+			mUseMethodA = true;
+		}
+
+		return static_cast<uint64_t>(skip);
+	}
+
+private:
+	double mRemainingPopulationSize;
+	uint64_t mRemainingSampleSize;
+	uint64_t mNextIndex = 0;
+	double mVprime = 0.0;
+	bool mUseMethodA = false;
+	Rand mRand{std::random_device{}()};
+};
+
+/**
+ * Returns sampleSize distinct uniformly selected indices out of [0, populationSize) in increasing order
+ */
+template<typename Rand>
+std::vector<uint64_t> sampleIndices(uint64_t populationSize, uint64_t sampleSize, Rand& rand)
+{
+	SequentialSampler<Rand&> sampler(populationSize, sampleSize, rand);
+	std::vector<uint64_t> result;
+	result.reserve(static_cast<size_t>(std::min(sampleSize, populationSize)));
+	while (sampler.hasNext())
+	{
+		result.push_back(sampler.next());
+	}
+	return result;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+/**
+ * Feeds count elements to a uniform sampler (ReservoirSampler or ReservoirSamplerStatic) using skip-ahead,
+ * getValue(index) is called only for the elements that the sampler is going to consider.
+ * A skip that goes past the last element is not lost, it continues in the next elements fed to the same sampler.
+ */
+template<typename Sampler, typename ValueFunc>
+void sampleElementsSkippingWith(Sampler& sampler, size_t count, ValueFunc&& getValue)
+{
+	size_t index = 0;
+	while (index < count)
+	{
+		const size_t skippedElementsCount = std::min(static_cast<size_t>(sampler.getNextSkippedElementsCount()), count - index);
+		sampler.jumpAhead(skippedElementsCount);
+		index += skippedElementsCount;
+
+		if (index < count)
+		{
+			sampler.sampleElement(getValue(index));
+			++index;
+		}
+	}
+}
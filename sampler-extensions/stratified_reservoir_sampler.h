@@ -0,0 +1,311 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * Keeps a separate uniform sample of up to sampleSize elements for every key (stratum).
+ *
+ * Strata are stored in an open-addressing hash table (linear probing) and the samples of all
+ * strata share one flat array of elements split into blocks of sampleSize, so adding an element
+ * doesn't allocate unless a new stratum is created and no node-based containers are involved.
+ *
+ * Optionally the amount of strata can be limited, when a new key is added to a full sampler
+ * the least recently active stratum is evicted (approximated with the CLOCK algorithm).
+ *
+ * T should be default constructible and move assignable, the slots of the blocks are reused.
+ */
+template<typename Key, typename T, typename Hash = std::hash<Key>, typename Rand = std::mt19937>
+class StratifiedReservoirSampler
+{
+	static_assert(std::is_default_constructible_v<T> && std::is_move_assignable_v<T>, "Elements should be default constructible and move assignable");
+
+public:
+	struct Result
+	{
+		const T* data;
+		size_t size;
+
+		const T* begin() const { return data; }
+		const T* end() const { return data + size; }
+	};
+
+public:
+	/**
+	 * maxStrataCount of zero means that the amount of strata is not limited
+	 */
+	explicit StratifiedReservoirSampler(size_t sampleSize, size_t maxStrataCount = 0)
+		: mSampleSize(sampleSize)
+		, mMaxStrataCount(maxStrataCount)
+	{
+	}
+
+	template<typename RandArg>
+	StratifiedReservoirSampler(size_t sampleSize, size_t maxStrataCount, RandArg&& rand)
+		: mSampleSize(sampleSize)
+		, mMaxStrataCount(maxStrataCount)
+		, mRand(std::forward<RandArg>(rand))
+	{
+	}
+
+	void sampleElement(const Key& key, const T& value)
+	{
+		sampleElementEmplace(key, value);
+	}
+
+	void sampleElement(const Key& key, T&& value)
+	{
+		sampleElementEmplace(key, std::move(value));
+	}
+
+	template<typename... Args>
+	void sampleElementEmplace(const Key& key, Args&&... arguments)
+	{
+		if (mSampleSize == 0)
+		{
+			return;
+		}
+
+		Stratum& stratum = mTable[findOrAddStratum(key)];
+		stratum.isRecentlyUsed = true;
+		T* block = mValues.data() + stratum.blockIndex * mSampleSize;
+
+		if (stratum.filledElementsCount < mSampleSize)
+		{
+			block[stratum.filledElementsCount] = T(std::forward<Args>(arguments)...);
+			++stratum.filledElementsCount;
+		}
+		else
+		{
+			std::uniform_int_distribution<uint64_t> distribution(0, stratum.processedElementsCount);
+			const uint64_t index = distribution(mRand);
+			if (index < mSampleSize)
+			{
+				block[index] = T(std::forward<Args>(arguments)...);
+			}
+		}
+		++stratum.processedElementsCount;
+	}
+
+	/**
+	 * Returns the sample of the stratum, or an empty result if there is no such stratum
+	 */
+	[[nodiscard]] Result getResult(const Key& key) const
+	{
+		const size_t index = findStratum(key, Hash{}(key));
+		if (index == NotFound)
+		{
+			return Result{nullptr, 0};
+		}
+		return getStratumResult(mTable[index]);
+	}
+
+	/**
+	 * Amount of elements of the stratum seen since it was created
+	 */
+	[[nodiscard]] uint64_t getProcessedElementsCount(const Key& key) const
+	{
+		const size_t index = findStratum(key, Hash{}(key));
+		return index == NotFound ? 0 : mTable[index].processedElementsCount;
+	}
+
+	/**
+	 * Calls func(const Key&, Result) for every stratum in unspecified order
+	 */
+	template<typename Func>
+	void forEachStratum(Func&& func) const
+	{
+		for (const Stratum& stratum : mTable)
+		{
+			if (stratum.isOccupied)
+			{
+				func(stratum.key, getStratumResult(stratum));
+			}
+		}
+	}
+
+	[[nodiscard]] size_t getStrataCount() const
+	{
+		return mStrataCount;
+	}
+
+	void reset()
+	{
+		mTable.clear();
+		mValues.clear();
+		mFreeBlocks.clear();
+		mStrataCount = 0;
+		mBlocksCount = 0;
+		mClockHand = 0;
+	}
+
+private:
+	struct Stratum
+	{
+		Key key{};
+		size_t hash = 0;
+		uint64_t processedElementsCount = 0;
+		size_t filledElementsCount = 0;
+		size_t blockIndex = 0;
+		bool isOccupied = false;
+		bool isRecentlyUsed = false;
+	};
+
+	static constexpr size_t NotFound = static_cast<size_t>(-1);
+	static constexpr size_t MinTableSize = 16;
+
+	Result getStratumResult(const Stratum& stratum) const
+	{
+		return Result{mValues.data() + stratum.blockIndex * mSampleSize, stratum.filledElementsCount};
+	}
+
+	size_t getIdealIndex(size_t hash) const
+	{
+		// Fibonacci hashing spreads poor hashes (e.g. identity hash of integers) over the table
+		return static_cast<size_t>((static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ull) >> 32) & (mTable.size() - 1);
+	}
+
+	size_t findStratum(const Key& key, size_t hash) const
+	{
+		if (mTable.empty())
+		{
+			return NotFound;
+		}
+
+		const size_t mask = mTable.size() - 1;
+		for (size_t index = getIdealIndex(hash); mTable[index].isOccupied; index = (index + 1) & mask)
+		{
+			if (mTable[index].hash == hash && mTable[index].key == key)
+			{
+				return index;
+			}
+		}
+		return NotFound;
+	}
+
+	size_t findOrAddStratum(const Key& key)
+	{
+		const size_t hash = Hash{}(key);
+		const size_t existingIndex = findStratum(key, hash);
+		if (existingIndex != NotFound)
+		{
+			return existingIndex;
+		}
+
+		if (mMaxStrataCount > 0 && mStrataCount >= mMaxStrataCount)
+		{
+			evictLeastActiveStratum();
+		}
+
+		// keep the load factor at or below 1/2 to keep the probe sequences short
+		if ((mStrataCount + 1) * 2 > mTable.size())
+		{
+			rehash(std::max(MinTableSize, mTable.size() * 2));
+		}
+
+		const size_t mask = mTable.size() - 1;
+		size_t index = getIdealIndex(hash);
+		while (mTable[index].isOccupied)
+		{
+			index = (index + 1) & mask;
+		}
+
+		Stratum& stratum = mTable[index];
+		stratum = Stratum{};
+		stratum.key = key;
+		stratum.hash = hash;
+		stratum.blockIndex = allocateBlock();
+		stratum.isOccupied = true;
+		++mStrataCount;
+		return index;
+	}
+
+	size_t allocateBlock()
+	{
+		if (!mFreeBlocks.empty())
+		{
+			const size_t blockIndex = mFreeBlocks.back();
+			mFreeBlocks.pop_back();
+			return blockIndex;
+		}
+
+		mValues.resize((mBlocksCount + 1) * mSampleSize);
+		return mBlocksCount++;
+	}
+
+	void evictLeastActiveStratum()
+	{
+		// second-chance sweep: strata used since the last sweep are skipped once
+		const size_t mask = mTable.size() - 1;
+		while (true)
+		{
+			Stratum& stratum = mTable[mClockHand];
+			if (stratum.isOccupied)
+			{
+				if (!stratum.isRecentlyUsed)
+				{
+					mFreeBlocks.push_back(stratum.blockIndex);
+					eraseAt(mClockHand);
+					return;
+				}
+				stratum.isRecentlyUsed = false;
+			}
+			mClockHand = (mClockHand + 1) & mask;
+		}
+	}
+
+	void eraseAt(size_t index)
+	{
+		// backward shift deletion keeps the probe sequences valid without tombstones
+		const size_t mask = mTable.size() - 1;
+		size_t hole = index;
+		mTable[hole].isOccupied = false;
+		for (size_t next = (hole + 1) & mask; mTable[next].isOccupied; next = (next + 1) & mask)
+		{
+			const size_t idealIndex = getIdealIndex(mTable[next].hash);
+			if (((next - idealIndex) & mask) >= ((next - hole) & mask))
+			{
+				mTable[hole] = std::move(mTable[next]);
+				mTable[next].isOccupied = false;
+				hole = next;
+			}
+		}
+		--mStrataCount;
+	}
+
+	void rehash(size_t newTableSize)
+	{
+		std::vector<Stratum> oldTable(newTableSize);
+		std::swap(oldTable, mTable);
+		mClockHand = 0;
+
+		const size_t mask = mTable.size() - 1;
+		for (Stratum& stratum : oldTable)
+		{
+			if (stratum.isOccupied)
+			{
+				size_t index = getIdealIndex(stratum.hash);
+				while (mTable[index].isOccupied)
+				{
+					index = (index + 1) & mask;
+				}
+				mTable[index] = std::move(stratum);
+			}
+		}
+	}
+
+private:
+	size_t mSampleSize;
+	size_t mMaxStrataCount;
+	size_t mStrataCount = 0;
+	size_t mBlocksCount = 0;
+	size_t mClockHand = 0;
+	std::vector<Stratum> mTable;
+	std::vector<T> mValues;
+	std::vector<size_t> mFreeBlocks;
+	Rand mRand{std::random_device{}()};
+};
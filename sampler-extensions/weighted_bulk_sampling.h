@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+/**
+ * Feeds a batch of weights to a weighted sampler (ReservoirSamplerWeighted or ReservoirSamplerWeightedStatic),
+ * getValue(index) is called only for the elements that the sampler is going to consider.
+ * This allows the values to stay in a separate column and be read or built only for the survivors.
+ * Samplers that can't tell in advance if an element will be considered (e.g. ReservoirSamplerLinear)
+ * are accepted too, but getValue is called for every element then.
+ */
+template<typename WeightedSampler, typename Weight, typename ValueFunc>
+void sampleElementsWith(WeightedSampler& sampler, const Weight* weights, size_t count, ValueFunc&& getValue)
+{
+	for (size_t i = 0; i < count; ++i)
+	{
+		if constexpr (requires(WeightedSampler& s, const Weight& w) { s.willNextElementBeConsidered(w); s.skipNextElement(w); })
+		{
+			if (sampler.willNextElementBeConsidered(weights[i]))
+			{
+				sampler.sampleElement(weights[i], getValue(i));
+			}
+			else
+			{
+				sampler.skipNextElement(weights[i]);
+			}
+		}
+		else
+		{
+			sampler.sampleElement(weights[i], getValue(i));
+		}
+	}
+}
+
+/**
+ * Feeds parallel arrays of weights and values to a weighted sampler,
+ * values are copied only for the elements that the sampler is going to consider
+ */
+template<typename WeightedSampler, typename Weight, typename T>
+void sampleElements(WeightedSampler& sampler, const Weight* weights, const T* values, size_t count)
+{
+	sampleElementsWith(sampler, weights, count, [values](size_t index) -> const T& { return values[index]; });
+}
+
+/**
+ * Feeds parallel contiguous columns of weights and values (e.g. std::span, std::vector or std::array)
+ * to a weighted sampler, the columns should have the same size
+ */
+template<typename WeightedSampler, typename WeightColumn, typename ValueColumn>
+void sampleElements(WeightedSampler& sampler, const WeightColumn& weights, const ValueColumn& values)
+{
+	assert(std::size(weights) == std::size(values));
+
+	sampleElements(sampler, std::data(weights), std::data(values), std::size(weights));
+}
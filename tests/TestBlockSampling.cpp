@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include "sampler-extensions/block_sampling.h"
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "reservoir-sampler/reservoir_sampler.h"
+#include "reservoir-sampler/reservoir_sampler_static.h"
+#include "reservoir-sampler/reservoir_sampler_weighted.h"
+
+#include "MonteCarloTrials.h"
+
+TEST(BlockSampling, SamplerOfSizeFive_FirstBlock_AcceptsFirstFivePositions)
+{
+	std::array<int, 64> values;
+	std::iota(values.begin(), values.end(), 0);
+
+	ReservoirSampler<int> sampler(5);
+	const BlockAcceptMask<64> acceptMask = sampleBlock<64>(sampler, values.data(), values.size());
+
+	for (size_t i = 0; i < 5; ++i)
+	{
+		EXPECT_TRUE(acceptMask.test(i));
+	}
+
+	std::vector<int> result = sampler.consumeResult();
+	std::sort(result.begin(), result.end());
+	ASSERT_EQ(static_cast<size_t>(5), result.size());
+	// every value that was sampled should be marked as accepted
+	for (int value : result)
+	{
+		EXPECT_TRUE(acceptMask.test(static_cast<size_t>(value)));
+	}
+}
+
+TEST(BlockSampling, SamplerOfSizeFive_ShortLastBlock_DoesNotAcceptPositionsAfterCount)
+{
+	std::array<int, 3> values{1, 2, 3};
+
+	ReservoirSamplerStatic<int, 5> sampler;
+	const BlockAcceptMask<256> acceptMask = sampleBlock<256>(sampler, values.data(), values.size());
+
+	EXPECT_EQ(static_cast<size_t>(3), acceptMask.count());
+	EXPECT_EQ(static_cast<size_t>(3), sampler.getResultSize());
+}
+
+TEST(BlockSampling, WarmSamplerOfSizeFive_LongStreamOfBlocks_ValuesAreReadOnlyForAcceptedPositions)
+{
+	ReservoirSampler<size_t> sampler(5);
+	size_t readValuesCount = 0;
+	size_t acceptedCount = 0;
+	for (size_t block = 0; block < 1000; ++block)
+	{
+		const BlockAcceptMask<256> acceptMask = sampleBlockWith<256>(sampler, 256, [&readValuesCount, block](size_t index)
+		{
+			++readValuesCount;
+			return block * 256 + index;
+		});
+		acceptedCount += acceptMask.count();
+	}
+
+	EXPECT_EQ(acceptedCount, readValuesCount);
+	EXPECT_LT(readValuesCount, static_cast<size_t>(1000));
+	EXPECT_EQ(static_cast<size_t>(5), sampler.getResultSize());
+}
+
+TEST(BlockSampling, WeightedSamplerOfSizeFive_BlockOfThreeElements_AcceptsAllPositions)
+{
+	std::array<float, 3> weights{1.0f, 2.0f, 3.0f};
+	std::array<int, 3> values{10, 11, 12};
+
+	ReservoirSamplerWeighted<int> sampler(5);
+	const BlockAcceptMask<64> acceptMask = sampleWeightedBlock<64>(sampler, weights.data(), values.data(), values.size());
+
+	EXPECT_EQ(BlockAcceptMask<64>(0b111), acceptMask);
+
+	std::vector<int> result = sampler.consumeResult();
+	std::sort(result.begin(), result.end());
+	EXPECT_EQ(std::vector<int>({10, 11, 12}), result);
+}
+
+TEST(BlockSampling, SamplerSizeOfFive_BlocksOfFour_ProducesEqualFrequencies)
+{
+	std::array<int, 20> values;
+	std::iota(values.begin(), values.end(), 0);
+
+	const std::array<int, 20> frequences = runParallelTrials<std::array<int, 20>>(10000, [&values](std::mt19937& rand, std::array<int, 20>& trialFrequences)
+	{
+		ReservoirSampler<int, std::mt19937&> sampler(5, rand);
+		for (size_t block = 0; block < values.size(); block += 4)
+		{
+			sampleBlock<4>(sampler, values.data() + block, 4);
+		}
+
+		const auto [data, size] = sampler.getResult();
+		for (size_t k = 0; k < size; ++k)
+		{
+			++trialFrequences[data[k]];
+		}
+	});
+
+	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
+	ASSERT_EQ(5.0f * 10000, frequencySum);
+	for (int freq : frequences)
+	{
+		EXPECT_NEAR(0.05f, freq/frequencySum, 0.01f);
+	}
+}
+
+TEST(BlockSampling, WeightedSamplerSizeOfFive_BlocksOfEqualWeights_ProducesEqualFrequencies)
+{
+	std::vector<float> weights(20, 1.0f);
+	std::array<int, 20> values;
+	std::iota(values.begin(), values.end(), 0);
+
+	const std::array<int, 20> frequences = runParallelTrials<std::array<int, 20>>(10000, [&weights, &values](std::mt19937& rand, std::array<int, 20>& trialFrequences)
+	{
+		ReservoirSamplerWeighted<int, float, std::mt19937&> sampler(5, rand);
+		for (size_t block = 0; block < values.size(); block += 8)
+		{
+			sampleWeightedBlock<8>(sampler, weights.data() + block, values.data() + block, std::min<size_t>(8, values.size() - block));
+		}
+
+		const auto [data, size] = sampler.getResult();
+		for (size_t k = 0; k < size; ++k)
+		{
+			++trialFrequences[data[k]];
+		}
+	});
+
+	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
+	ASSERT_EQ(5.0f * 10000, frequencySum);
+	for (int freq : frequences)
+	{
+		EXPECT_NEAR(0.05f, freq/frequencySum, 0.01f);
+	}
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include "sampler-extensions/columnar_batch_sampler.h"
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "MonteCarloTrials.h"
+
+TEST(ColumnarBatchSampler, UniformSamplerOfSizeFive_BatchOfThreeRows_ReturnsAllRowsInOrder)
+{
+	ColumnarBatchSamplerUniform<> sampler(5);
+	sampler.sampleBatch({3, nullptr});
+
+	const std::vector<SampledRow> rows = sampler.consumeSampledRows();
+	EXPECT_EQ(std::vector<SampledRow>({{0, 0}, {0, 1}, {0, 2}}), rows);
+}
+
+TEST(ColumnarBatchSampler, UniformSamplerOfSizeFive_SeveralBatches_ColumnsAreGatheredFromSampledRows)
+{
+	const std::vector<int> firstIds({1, 2, 3});
+	const std::vector<std::string> firstNames({"a", "b", "c"});
+	const std::vector<int> secondIds({4, 5});
+	const std::vector<std::string> secondNames({"d", "e"});
+
+	ColumnarBatchSamplerUniform<> sampler(5);
+	sampler.sampleBatch({firstIds.size(), nullptr});
+	sampler.sampleBatch({secondIds.size(), nullptr});
+	EXPECT_EQ(static_cast<uint64_t>(2), sampler.getProcessedBatchesCount());
+
+	const std::vector<SampledRow> rows = sampler.consumeSampledRows();
+	const std::vector<int> ids = gatherSampledRows<int>(rows, [&](uint64_t batchIndex){ return batchIndex == 0 ? firstIds.data() : secondIds.data(); });
+	const std::vector<std::string> names = gatherSampledRows<std::string>(rows, [&](uint64_t batchIndex){ return batchIndex == 0 ? firstNames.data() : secondNames.data(); });
+
+	EXPECT_EQ(std::vector<int>({1, 2, 3, 4, 5}), ids);
+	EXPECT_EQ(std::vector<std::string>({"a", "b", "c", "d", "e"}), names);
+}
+
+TEST(ColumnarBatchSampler, WeightedSampler_BatchWithWeightColumn_ReturnsSortedDistinctRows)
+{
+	const std::vector<float> weights({1.0f, 5.0f, 2.0f, 8.0f, 1.0f, 3.0f, 4.0f, 2.0f});
+	std::mt19937 rand{std::random_device{}()};
+
+	const std::vector<size_t> rowIndices = sampleRowIndices(ColumnarBatch<float>{weights.size(), weights.data()}, 3, rand);
+
+	ASSERT_EQ(static_cast<size_t>(3), rowIndices.size());
+	EXPECT_TRUE(std::is_sorted(rowIndices.begin(), rowIndices.end()));
+	EXPECT_TRUE(std::adjacent_find(rowIndices.begin(), rowIndices.end()) == rowIndices.end());
+	EXPECT_LT(rowIndices.back(), weights.size());
+}
+
+TEST(ColumnarBatchSampler, UniformSampler_LargeBatches_SampledRowsAreWithinBatches)
+{
+	ColumnarBatchSamplerUniform<> sampler(10);
+	for (int i = 0; i < 10; ++i)
+	{
+		sampler.sampleBatch({100000, nullptr});
+	}
+
+	const std::vector<SampledRow> rows = sampler.consumeSampledRows();
+	ASSERT_EQ(static_cast<size_t>(10), rows.size());
+	for (const SampledRow& row : rows)
+	{
+		EXPECT_LT(row.batchIndex, static_cast<uint64_t>(10));
+		EXPECT_LT(row.rowIndex, static_cast<uint64_t>(100000));
+	}
+}
+
+TEST(ColumnarBatchSampler, UniformSamplerSizeOfFive_FourBatchesOfFiveRows_ProducesEqualFrequencies)
+{
+	const std::array<int, 20> frequences = runParallelTrials<std::array<int, 20>>(10000, [](std::mt19937& rand, std::array<int, 20>& trialFrequences)
+	{
+		ColumnarBatchSamplerUniform<std::mt19937&> sampler(5, rand);
+		for (int batch = 0; batch < 4; ++batch)
+		{
+			sampler.sampleBatch({5, nullptr});
+		}
+
+		for (const SampledRow& row : sampler.consumeSampledRows())
+		{
+			++trialFrequences[row.batchIndex * 5 + row.rowIndex];
+		}
+	});
+
+	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
+	ASSERT_EQ(5.0f * 10000, frequencySum);
+	for (int freq : frequences)
+	{
+		EXPECT_NEAR(0.05f, freq/frequencySum, 0.01f);
+	}
+}
+
+TEST(ColumnarBatchSampler, WeightedSamplerSizeOfOne_BatchesWithAndWithoutWeights_ProducesExpectedFrequencies)
+{
+	// the second batch has no weight column, so its rows have weight of one
+	const std::array<float, 4> weights{1.0f, 2.0f, 3.0f, 4.0f};
+	const std::array<float, 6> expectedFrequencies{1.0f / 12, 2.0f / 12, 3.0f / 12, 4.0f / 12, 1.0f / 12, 1.0f / 12};
+
+	const std::array<int, 6> frequences = runParallelTrials<std::array<int, 6>>(100000, [&weights](std::mt19937& rand, std::array<int, 6>& trialFrequences)
+	{
+		ColumnarBatchSamplerWeighted<float, std::mt19937&> sampler(1, rand);
+		sampler.sampleBatch({weights.size(), weights.data()});
+		sampler.sampleBatch({2, nullptr});
+
+		for (const SampledRow& row : sampler.consumeSampledRows())
+		{
+			++trialFrequences[row.batchIndex * weights.size() + row.rowIndex];
+		}
+	});
+
+	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
+	ASSERT_EQ(100000.0f, frequencySum);
+	for (size_t i = 0; i < frequences.size(); ++i)
+	{
+		EXPECT_NEAR(expectedFrequencies[i], frequences[i]/frequencySum, 0.01f);
+	}
+}
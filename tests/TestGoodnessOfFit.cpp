@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include "sampler-extensions/goodness_of_fit.h"
+
+#include <array>
+#include <random>
+
+#include "reservoir-sampler/reservoir_sampler.h"
+#include "reservoir-sampler/reservoir_sampler_linear.h"
+
+#include "MonteCarloTrials.h"
+
+TEST(GoodnessOfFit, ChiSquarePValue_KnownCriticalValues_ReturnsExpectedProbabilities)
+{
+	EXPECT_NEAR(0.05, getChiSquarePValue(3.841459, 1.0), 1e-6);
+	EXPECT_NEAR(0.05, getChiSquarePValue(18.307038, 10.0), 1e-6);
+	EXPECT_NEAR(0.01, getChiSquarePValue(36.190869, 19.0), 1e-6);
+	EXPECT_NEAR(0.5, getChiSquarePValue(99.334129, 100.0), 1e-6);
+	EXPECT_DOUBLE_EQ(1.0, getChiSquarePValue(0.0, 5.0));
+}
+
+TEST(GoodnessOfFit, KolmogorovPValue_KnownCriticalValues_ReturnsExpectedProbabilities)
+{
+	EXPECT_NEAR(0.05, getKolmogorovPValue(1.358099), 1e-5);
+	EXPECT_NEAR(0.01, getKolmogorovPValue(1.627624), 1e-5);
+	EXPECT_DOUBLE_EQ(1.0, getKolmogorovPValue(0.1));
+}
+
+TEST(GoodnessOfFit, ChiSquareTest_CountsMatchingProbabilities_ReturnsHighPValue)
+{
+	const std::array<int, 4> counts{100, 200, 300, 400};
+	const std::array<double, 4> probabilities{0.1, 0.2, 0.3, 0.4};
+
+	const GoodnessOfFitResult result = chiSquareTest(counts, probabilities);
+
+	EXPECT_DOUBLE_EQ(0.0, result.statistic);
+	EXPECT_DOUBLE_EQ(1.0, result.pValue);
+}
+
+TEST(GoodnessOfFit, ChiSquareTest_SkewedCounts_ReturnsLowPValue)
+{
+	const std::array<int, 4> counts{250, 250, 250, 250};
+	const std::array<double, 4> probabilities{0.1, 0.2, 0.3, 0.4};
+
+	const GoodnessOfFitResult result = chiSquareTest(counts, probabilities);
+
+	EXPECT_LT(result.pValue, 1e-10);
+}
+
+TEST(GoodnessOfFit, KolmogorovSmirnovTest_ValuesFromDifferentDistribution_ReturnsLowPValue)
+{
+	std::mt19937 rand{std::random_device{}()};
+	std::uniform_real_distribution<double> distribution(0.0, 1.0);
+	std::vector<double> values(1000);
+	for (double& value : values)
+	{
+		// squared uniform values are skewed towards zero
+		value = distribution(rand) * distribution(rand);
+	}
+
+	const GoodnessOfFitResult result = kolmogorovSmirnovTest(std::move(values), [](double value){ return value; });
+
+	EXPECT_LT(result.pValue, 1e-6);
+}
+
+TEST(GoodnessOfFit, UniformInclusionTest_SkewedSampling_ReturnsLowPValue)
+{
+	// the first element is sampled slightly more often than the others
+	const std::array<int, 4> inclusionCounts{5300, 4900, 4900, 4900};
+
+	const GoodnessOfFitResult result = chiSquareUniformInclusionTest(inclusionCounts, 2);
+
+	EXPECT_LT(result.pValue, 1e-4);
+}
+
+TEST(GoodnessOfFit, SamplerOfSizeFive_SamplingFromStreamOfTwenty_PassesUniformInclusionTest)
+{
+	const std::array<int, 20> frequences = runParallelTrials<std::array<int, 20>>(10000, [](std::mt19937& rand, std::array<int, 20>& trialFrequences)
+	{
+		ReservoirSampler<int, std::mt19937&> sampler(5, rand);
+		for (int n = 0; n < 20; ++n)
+		{
+			sampler.sampleElement(n);
+		}
+
+		for (int item : sampler.getResult())
+		{
+			++trialFrequences[item];
+		}
+	});
+
+	// the probability of a false failure is one in a million
+	EXPECT_GT(chiSquareUniformInclusionTest(frequences, 5).pValue, 1e-6);
+}
+
+TEST(GoodnessOfFit, LinearSampler_SamplingFromStreamOfEqualWeights_PassesKolmogorovSmirnovTest)
+{
+	constexpr int StreamSize = 1000;
+	std::mt19937 rand{std::random_device{}()};
+	std::vector<double> positions;
+	for (int i = 0; i < 2000; ++i)
+	{
+		ReservoirSamplerLinear<int, int, std::mt19937&> sampler(rand);
+		for (int n = 0; n < StreamSize; ++n)
+		{
+			sampler.sampleElement(1, n);
+		}
+
+		const auto result = sampler.getResult();
+		ASSERT_TRUE(result.has_value());
+		// center of the element's cell in [0, 1) to make the discrete distribution close to the continuous one
+		positions.push_back((*result + 0.5) / StreamSize);
+	}
+
+	EXPECT_GT(kolmogorovSmirnovTest(std::move(positions), [](double value){ return value; }).pValue, 1e-6);
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include "sampler-extensions/sampler_instrumentation.h"
+
+#include <array>
+#include <string>
+
+#include "reservoir-sampler/reservoir_sampler.h"
+#include "reservoir-sampler/reservoir_sampler_static.h"
+#include "reservoir-sampler/reservoir_sampler_weighted.h"
+
+namespace LargeElementMovesTestsInternal
+{
+	// element with an inline buffer, every move is a copy of the whole buffer
+	template<size_t Size>
+	struct InlineBuffer
+	{
+		explicit InlineBuffer(int id)
+			: id(id)
+		{
+			data.fill(static_cast<char>(id));
+		}
+
+		int id;
+		std::array<char, Size> data;
+	};
+
+	using Buffer4K = CountedElement<InlineBuffer<4096>>;
+
+	std::string makeLongString(int id)
+	{
+		return std::string(8192, static_cast<char>('a' + id % 26)) + std::to_string(id);
+	}
+}
+
+TEST(LargeElementMoves, SamplerOf4KBuffers_LongStreamEmplaced_AtMostOneMovePerStoredElement)
+{
+	using namespace LargeElementMovesTestsInternal;
+
+	InstrumentedSampler<ReservoirSampler<Buffer4K>, true> sampler(16);
+	for (int n = 0; n < 100000; ++n)
+	{
+		sampler.sampleElementEmplace(n);
+	}
+
+	const SamplerInstrumentationStats& stats = sampler.getStats();
+	EXPECT_EQ(stats.storedElementsCount, stats.elementConstructionsCount);
+	EXPECT_EQ(static_cast<uint64_t>(0), stats.elementCopiesCount);
+	EXPECT_LE(stats.elementMovesCount, stats.replacedElementsCount);
+	// only a tiny fraction of a long stream gets to the reservoir
+	EXPECT_LT(stats.storedElementsCount, static_cast<uint64_t>(1000));
+
+	for (const Buffer4K& element : sampler.getResult())
+	{
+		EXPECT_EQ(static_cast<char>(element.value.id), element.value.data.back());
+	}
+}
+
+TEST(LargeElementMoves, StaticSamplerOf4KBuffers_LongStreamEmplaced_AtMostOneMovePerStoredElement)
+{
+	using namespace LargeElementMovesTestsInternal;
+
+	InstrumentedSampler<ReservoirSamplerStatic<Buffer4K, 16>, true> sampler;
+	for (int n = 0; n < 100000; ++n)
+	{
+		sampler.sampleElementEmplace(n);
+	}
+
+	const SamplerInstrumentationStats& stats = sampler.getStats();
+	EXPECT_EQ(stats.storedElementsCount, stats.elementConstructionsCount);
+	EXPECT_EQ(static_cast<uint64_t>(0), stats.elementCopiesCount);
+	EXPECT_LE(stats.elementMovesCount, stats.replacedElementsCount);
+}
+
+TEST(LargeElementMoves, WeightedSamplerOf4KBuffers_LongStreamEmplaced_AtMostOneMovePerStoredElement)
+{
+	using namespace LargeElementMovesTestsInternal;
+
+	InstrumentedSampler<ReservoirSamplerWeighted<Buffer4K>, true> sampler(16);
+	for (int n = 0; n < 100000; ++n)
+	{
+		sampler.sampleElementEmplace(static_cast<float>(n % 10 + 1), n);
+	}
+
+	const SamplerInstrumentationStats& stats = sampler.getStats();
+	EXPECT_EQ(stats.storedElementsCount, stats.elementConstructionsCount);
+	EXPECT_EQ(static_cast<uint64_t>(0), stats.elementCopiesCount);
+	EXPECT_LE(stats.elementMovesCount, stats.storedElementsCount);
+}
+
+TEST(LargeElementMoves, SamplerOfLongStrings_MovedInOnlyWhenConsidered_NoCopiesAndContentIsKept)
+{
+	using namespace LargeElementMovesTestsInternal;
+
+	InstrumentedSampler<ReservoirSampler<CountedElement<std::string>>, true> sampler(16);
+	int constructedStringsCount = 0;
+	for (int n = 0; n < 100000; ++n)
+	{
+		if (sampler.willNextElementBeConsidered())
+		{
+			++constructedStringsCount;
+			sampler.sampleElement(makeLongString(n));
+		}
+		else
+		{
+			sampler.skipNextElement();
+		}
+	}
+
+	const SamplerInstrumentationStats& stats = sampler.getStats();
+	EXPECT_EQ(static_cast<uint64_t>(constructedStringsCount), stats.storedElementsCount);
+	EXPECT_EQ(static_cast<uint64_t>(0), stats.elementCopiesCount);
+	// the string is converted into the element and then moved into the reservoir
+	EXPECT_LE(stats.elementMovesCount, 2 * stats.storedElementsCount);
+
+	const std::vector<CountedElement<std::string>> result = sampler.consumeResult();
+	ASSERT_EQ(static_cast<size_t>(16), result.size());
+	for (const CountedElement<std::string>& element : result)
+	{
+		const int id = std::stoi(element.value.substr(8192));
+		EXPECT_EQ(makeLongString(id), element.value);
+	}
+}
+
+TEST(LargeElementMoves, SamplerOf4KBuffers_ResultConsumed_MovesEveryElementOnce)
+{
+	using namespace LargeElementMovesTestsInternal;
+
+	InstrumentedSampler<ReservoirSampler<Buffer4K>, true> sampler(16);
+	for (int n = 0; n < 1000; ++n)
+	{
+		sampler.sampleElementEmplace(n);
+	}
+	sampler.resetStats();
+
+	const std::vector<Buffer4K> result = sampler.consumeResult();
+
+	EXPECT_EQ(static_cast<size_t>(16), result.size());
+	// every element is moved into the returned vector, same as for ReservoirSampler of CopyMoveCounter
+	EXPECT_EQ(static_cast<uint64_t>(16), sampler.getStats().elementMovesCount);
+	EXPECT_EQ(static_cast<uint64_t>(0), sampler.getStats().elementCopiesCount);
+}
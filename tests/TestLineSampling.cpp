@@ -0,0 +1,317 @@
+#include <gtest/gtest.h>
+
+#include "tools/reservoir-sample/line_sampling.h"
+#include "tools/reservoir-sample/numa_topology.h"
+#include "tools/reservoir-sample/parallel_line_sampling.h"
+
+#include "reservoir-sampler/reservoir_sampler_weighted.h"
+
+#include <array>
+#include <numeric>
+#include <string>
+
+#include "MonteCarloTrials.h"
+
+TEST(LineSampling, TextWithAndWithoutTrailingSeparator_ForEachLine_VisitsAllLines)
+{
+	{
+		std::vector<std::string_view> lines;
+		forEachLine("first\nsecond\n\nfourth\n", [&lines](std::string_view line){ lines.push_back(line); });
+		EXPECT_EQ(std::vector<std::string_view>({"first", "second", "", "fourth"}), lines);
+	}
+
+	{
+		std::vector<std::string_view> lines;
+		forEachLine("first\nsecond", [&lines](std::string_view line){ lines.push_back(line); });
+		EXPECT_EQ(std::vector<std::string_view>({"first", "second"}), lines);
+	}
+
+	{
+		std::vector<std::string_view> lines;
+		forEachLine("", [&lines](std::string_view line){ lines.push_back(line); });
+		EXPECT_TRUE(lines.empty());
+	}
+}
+
+TEST(LineSampling, SamplerOfSizeFive_ThreeLinesSampled_HasAllLinesAsViewsIntoTheData)
+{
+	const std::string_view data = "10\n11\n12";
+
+	ReservoirSampler<std::string_view> sampler(5);
+	sampleLines(data, sampler);
+
+	std::vector<std::string_view> result = sampler.consumeResult();
+	std::sort(result.begin(), result.end());
+	ASSERT_EQ(std::vector<std::string_view>({"10", "11", "12"}), result);
+	for (std::string_view line : result)
+	{
+		EXPECT_TRUE(line.data() >= data.data() && line.data() + line.size() <= data.data() + data.size());
+	}
+}
+
+TEST(LineSampling, StreamSplitIntoSmallBlocks_SampledWithStreamLineSampler_ProducesWholeLines)
+{
+	const std::string data = "first line\nsecond\nthird line is the longest\nlast";
+
+	ReservoirSampler<std::string> sampler(10);
+	StreamLineSampler<ReservoirSampler<std::string>> lineSampler(sampler);
+	for (size_t blockBegin = 0; blockBegin < data.size(); blockBegin += 3)
+	{
+		lineSampler.consumeBlock(std::string_view(data).substr(blockBegin, 3));
+	}
+	lineSampler.finish();
+
+	std::vector<std::string> result = sampler.consumeResult();
+	std::sort(result.begin(), result.end());
+	EXPECT_EQ(std::vector<std::string>({"first line", "last", "second", "third line is the longest"}), result);
+}
+
+TEST(LineSampling, SamplerSizeOfFive_SamplingFromTwentyLines_ProducesEqualFrequencies)
+{
+	std::string data;
+	for (int n = 0; n < 20; ++n)
+	{
+		data += std::to_string(n) + "\n";
+	}
+
+	const std::array<int, 20> frequences = runParallelTrials<std::array<int, 20>>(10000, [&data](std::mt19937& rand, std::array<int, 20>& trialFrequences)
+	{
+		ReservoirSampler<std::string_view, std::mt19937&> sampler(5, rand);
+		sampleLines(data, sampler);
+
+		for (std::string_view line : sampler.getResult())
+		{
+			++trialFrequences[std::stoi(std::string(line))];
+		}
+	});
+
+	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
+	ASSERT_EQ(5.0f * 10000, frequencySum);
+	for (int freq : frequences)
+	{
+		EXPECT_NEAR(0.05f, freq/frequencySum, 0.01f);
+	}
+}
+
+TEST(LineSampling, SamplerSizeOfFive_SamplingTwoTextsOfTenLinesWithOneSampler_ProducesEqualFrequencies)
+{
+	std::string firstData;
+	std::string secondData;
+	for (int n = 0; n < 10; ++n)
+	{
+		firstData += std::to_string(n) + "\n";
+		secondData += std::to_string(n + 10) + "\n";
+	}
+
+	const std::array<int, 20> frequences = runParallelTrials<std::array<int, 20>>(10000, [&firstData, &secondData](std::mt19937& rand, std::array<int, 20>& trialFrequences)
+	{
+		// a skip that goes past the end of the first text should continue in the second one
+		ReservoirSampler<std::string_view, std::mt19937&> sampler(5, rand);
+		sampleLines(firstData, sampler);
+		sampleLines(secondData, sampler);
+
+		for (std::string_view line : sampler.getResult())
+		{
+			++trialFrequences[std::stoi(std::string(line))];
+		}
+	});
+
+	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
+	ASSERT_EQ(5.0f * 10000, frequencySum);
+	for (int freq : frequences)
+	{
+		EXPECT_NEAR(0.05f, freq/frequencySum, 0.01f);
+	}
+}
+
+TEST(LineSampling, SamplerSizeOfFive_SamplingFromStreamOfTwentyLines_ProducesEqualFrequencies)
+{
+	std::string data;
+	for (int n = 0; n < 20; ++n)
+	{
+		data += std::to_string(n) + "\n";
+	}
+
+	const std::array<int, 20> frequences = runParallelTrials<std::array<int, 20>>(10000, [&data](std::mt19937& rand, std::array<int, 20>& trialFrequences)
+	{
+		ReservoirSampler<std::string, std::mt19937&> sampler(5, rand);
+		StreamLineSampler<ReservoirSampler<std::string, std::mt19937&>> lineSampler(sampler);
+		for (size_t blockBegin = 0; blockBegin < data.size(); blockBegin += 4)
+		{
+			lineSampler.consumeBlock(std::string_view(data).substr(blockBegin, 4));
+		}
+		lineSampler.finish();
+
+		for (const std::string& line : sampler.getResult())
+		{
+			++trialFrequences[std::stoi(line)];
+		}
+	});
+
+	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
+	ASSERT_EQ(5.0f * 10000, frequencySum);
+	for (int freq : frequences)
+	{
+		EXPECT_NEAR(0.05f, freq/frequencySum, 0.01f);
+	}
+}
+
+TEST(LineSampling, StreamSplitIntoSmallBlocks_SplitWithStreamLineSplitter_ProducesWholeLines)
+{
+	const std::string data = "first line\nsecond\n\nthird line is the longest\nlast";
+
+	std::vector<std::string> lines;
+	const auto addLine = [&lines](std::string_view line){ lines.emplace_back(line); };
+
+	StreamLineSplitter lineSplitter;
+	for (size_t blockBegin = 0; blockBegin < data.size(); blockBegin += 3)
+	{
+		lineSplitter.consumeBlock(std::string_view(data).substr(blockBegin, 3), addLine);
+	}
+	lineSplitter.finish(addLine);
+
+	EXPECT_EQ(std::vector<std::string>({"first line", "second", "", "third line is the longest", "last"}), lines);
+}
+
+TEST(LineSampling, RecordsWithDifferentWeightColumns_ParseWeightColumn_ReadsOnlyValidWeights)
+{
+	double weight = -1.0;
+	EXPECT_TRUE(parseWeightColumn("a\t2.5\tb", '\t', 1, weight));
+	EXPECT_EQ(2.5, weight);
+	EXPECT_TRUE(parseWeightColumn("a,b,7", ',', 2, weight));
+	EXPECT_EQ(7.0, weight);
+	EXPECT_TRUE(parseWeightColumn("3\r", ',', 0, weight));
+	EXPECT_EQ(3.0, weight);
+	EXPECT_TRUE(parseWeightColumn("0", ',', 0, weight));
+	EXPECT_EQ(0.0, weight);
+
+	EXPECT_FALSE(parseWeightColumn("a,b", ',', 2, weight));
+	EXPECT_FALSE(parseWeightColumn("a,,b", ',', 1, weight));
+	EXPECT_FALSE(parseWeightColumn("a,1x,b", ',', 1, weight));
+	EXPECT_FALSE(parseWeightColumn("a,-1,b", ',', 1, weight));
+	EXPECT_FALSE(parseWeightColumn("a,nan,b", ',', 1, weight));
+	EXPECT_FALSE(parseWeightColumn("a,inf,b", ',', 1, weight));
+}
+
+TEST(LineSampling, RecordsWithZeroAndInvalidWeights_SampleWeightedLines_SamplesOnlyPositiveWeights)
+{
+	const std::string_view data = "a\t0\nb\t5\nc\tx\nd\t1\ne\n";
+
+	ReservoirSamplerWeighted<std::string_view, double> sampler(5);
+	const size_t invalidRecordsCount = sampleWeightedLines(data, sampler, '\t', 1);
+	EXPECT_EQ(static_cast<size_t>(2), invalidRecordsCount);
+
+	std::vector<std::string_view> result = sampler.consumeResult();
+	std::sort(result.begin(), result.end());
+	EXPECT_EQ(std::vector<std::string_view>({"b\t5", "d\t1"}), result);
+}
+
+TEST(LineSampling, SamplerSizeOfOne_SamplingFromWeightedRecords_ProducesExpectedFrequencies)
+{
+	constexpr size_t elementsCount = 5;
+	const std::string data = "0,1\n1,2\n2,3\n3,4\n4,10\n";
+	const std::array<float, elementsCount> expectedFrequencies{1/20.0f, 2/20.0f, 3/20.0f, 4/20.0f, 10/20.0f};
+
+	const std::array<int, elementsCount> frequences = runParallelTrials<std::array<int, elementsCount>>(100000, [&data](std::mt19937& rand, std::array<int, elementsCount>& trialFrequences)
+	{
+		ReservoirSamplerWeighted<std::string_view, double, std::mt19937&> sampler(1, rand);
+		sampleWeightedLines(data, sampler, ',', 1);
+
+		for (std::string_view record : sampler.getResult())
+		{
+			++trialFrequences[static_cast<size_t>(record[0] - '0')];
+		}
+	});
+
+	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
+	ASSERT_EQ(100000.0f, frequencySum);
+	for (size_t i = 0; i < elementsCount; ++i)
+	{
+		EXPECT_NEAR(expectedFrequencies[i], frequences[i]/frequencySum, 0.01f);
+	}
+}
+
+TEST(LineSampling, TextWithLinesOfDifferentLength_SplitIntoChunks_ChunksAreLineAlignedAndCoverTheText)
+{
+	const std::string_view data = "a\nbb\nccccccccccccccc\nd\ne";
+
+	for (size_t chunksCount = 1; chunksCount < 10; ++chunksCount)
+	{
+		const std::vector<std::string_view> chunks = splitIntoLineAlignedChunks(data, chunksCount);
+		ASSERT_FALSE(chunks.empty());
+		EXPECT_GE(chunksCount, chunks.size());
+
+		std::vector<std::string_view> lines;
+		for (std::string_view chunk : chunks)
+		{
+			EXPECT_FALSE(chunk.empty());
+			forEachLine(chunk, [&lines](std::string_view line){ lines.push_back(line); });
+		}
+		EXPECT_EQ(std::vector<std::string_view>({"a", "bb", "ccccccccccccccc", "d", "e"}), lines);
+	}
+}
+
+TEST(LineSampling, SamplerSizeOfFive_SamplingTwentyLinesInParallel_ProducesEqualFrequencies)
+{
+	std::string data;
+	for (int n = 0; n < 20; ++n)
+	{
+		data += std::to_string(n) + "\n";
+	}
+
+	const std::array<int, 20> frequences = runParallelTrials<std::array<int, 20>>(2000, [&data](std::mt19937& rand, std::array<int, 20>& trialFrequences)
+	{
+		for (std::string_view line : sampleLinesParallel({data}, 5, 3, rand()))
+		{
+			++trialFrequences[std::stoi(std::string(line))];
+		}
+	});
+
+	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
+	ASSERT_EQ(5.0f * 2000, frequencySum);
+	for (int freq : frequences)
+	{
+		EXPECT_NEAR(0.05f, freq/frequencySum, 0.015f);
+	}
+}
+
+TEST(LineSampling, KernelCpuLists_Parse_ReturnsListedCpus)
+{
+	EXPECT_EQ(std::vector<int>({0, 1, 2, 3}), parseCpuList("0-3\n"));
+	EXPECT_EQ(std::vector<int>({0, 1, 4, 6, 7}), parseCpuList("0-1,4,6-7"));
+	EXPECT_EQ(std::vector<int>(), parseCpuList(""));
+	EXPECT_EQ(std::vector<int>(), parseCpuList("3-1"));
+	EXPECT_EQ(std::vector<int>(), parseCpuList("0-x"));
+}
+
+TEST(LineSampling, MissingSysfsDirectory_ReadNumaTopology_ReturnsNoNodes)
+{
+	EXPECT_TRUE(readNumaTopology("/nonexistent/devices/system/node").empty());
+}
+
+TEST(LineSampling, SamplerSizeOfFive_SamplingTwentyLinesOnTwoNumaNodes_ProducesEqualFrequencies)
+{
+	std::string data;
+	for (int n = 0; n < 20; ++n)
+	{
+		data += std::to_string(n) + "\n";
+	}
+
+	// nodes without CPUs, so the test threads are not pinned
+	const std::vector<NumaNode> numaNodes({NumaNode{0, {}}, NumaNode{1, {}}});
+
+	const std::array<int, 20> frequences = runParallelTrials<std::array<int, 20>>(2000, [&data, &numaNodes](std::mt19937& rand, std::array<int, 20>& trialFrequences)
+	{
+		for (std::string_view line : sampleLinesParallel({data}, 5, 3, rand(), numaNodes))
+		{
+			++trialFrequences[std::stoi(std::string(line))];
+		}
+	});
+
+	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
+	ASSERT_EQ(5.0f * 2000, frequencySum);
+	for (int freq : frequences)
+	{
+		EXPECT_NEAR(0.05f, freq/frequencySum, 0.015f);
+	}
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include "sampler-extensions/philox_random.h"
+
+#include <array>
+#include <numeric>
+#include <random>
+
+#include "reservoir-sampler/reservoir_sampler.h"
+#include "reservoir-sampler/reservoir_sampler_weighted.h"
+
+// known answers from the reference implementation (Random123)
+static_assert(Philox4x32::getBlock({0, 0, 0, 0}, {0, 0}) == Philox4x32::Block{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8});
+static_assert(Philox4x32::getBlock({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff}) == Philox4x32::Block{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd});
+static_assert(Philox4x32::getBlock({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, {0xa4093822, 0x299f31d0}) == Philox4x32::Block{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1});
+
+TEST(PhiloxRandom, GeneratorWithZeroSeed_FirstNumbers_AreTheFirstBlock)
+{
+	Philox4x32 rand(0);
+
+	EXPECT_EQ(0x6627e8d5u, rand());
+	EXPECT_EQ(0xe169c58du, rand());
+	EXPECT_EQ(0xbc57ac4cu, rand());
+	EXPECT_EQ(0x9b00dbd8u, rand());
+	EXPECT_EQ(Philox4x32::getBlock({1, 0, 0, 0}, {0, 0})[0], rand());
+}
+
+TEST(PhiloxRandom, Generator_Discard_SameAsDrawingNumbers)
+{
+	for (unsigned long long count : {0ull, 1ull, 3ull, 4ull, 5ull, 17ull, 1000ull})
+	{
+		for (unsigned long long alreadyDrawn : {0ull, 1ull, 2ull, 4ull})
+		{
+			Philox4x32 drawingRand(42, 7);
+			Philox4x32 discardingRand(42, 7);
+			for (unsigned long long i = 0; i < alreadyDrawn; ++i)
+			{
+				drawingRand();
+				discardingRand();
+			}
+
+			for (unsigned long long i = 0; i < count; ++i)
+			{
+				drawingRand();
+			}
+			discardingRand.discard(count);
+
+			EXPECT_EQ(drawingRand(), discardingRand());
+			EXPECT_TRUE(drawingRand == discardingRand);
+		}
+	}
+}
+
+TEST(PhiloxRandom, GeneratorsWithDifferentStreams_SameSeed_ProduceDifferentNumbers)
+{
+	Philox4x32 firstStream(42, 0);
+	Philox4x32 secondStream(42, 1);
+	Philox4x32 otherSeed(43, 0);
+
+	int equalCount = 0;
+	for (int i = 0; i < 100; ++i)
+	{
+		const uint32_t value = firstStream();
+		equalCount += (value == secondStream()) + (value == otherSeed());
+	}
+	EXPECT_EQ(0, equalCount);
+}
+
+TEST(PhiloxRandom, SamplersWithSameSeedAndStream_SameStream_ProduceIdenticalResults)
+{
+	auto sampleShard = [](uint64_t shardId)
+	{
+		ReservoirSampler<int, Philox4x32> sampler(10, Philox4x32(12345, shardId));
+		for (int n = 0; n < 10000; ++n)
+		{
+			sampler.sampleElement(n);
+		}
+		return sampler.consumeResult();
+	};
+
+	EXPECT_EQ(sampleShard(3), sampleShard(3));
+	EXPECT_NE(sampleShard(3), sampleShard(4));
+}
+
+TEST(PhiloxRandom, SamplerSizeOfFive_SamplingFromStreamOfTwenty_ProducesEqualFrequencies)
+{
+	std::array<int, 20> frequences{};
+	// every trial uses its own substream
+	for (int i = 0; i < 10000; ++i)
+	{
+		ReservoirSampler<int, Philox4x32> sampler(5, Philox4x32(std::random_device{}(), static_cast<uint64_t>(i)));
+
+		for (int n = 0; n < 20; ++n)
+		{
+			sampler.sampleElement(n);
+		}
+
+		for (int item : sampler.getResult())
+		{
+			++frequences[item];
+		}
+	}
+
+	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
+	ASSERT_EQ(5.0f * 10000, frequencySum);
+	for (int freq : frequences)
+	{
+		EXPECT_NEAR(0.05f, freq/frequencySum, 0.01f);
+	}
+}
+
+TEST(PhiloxRandom, WeightedSamplerOfSizeFive_SamplingFromStreamOfTwenty_ProducesEqualFrequencies)
+{
+	std::array<int, 20> frequences{};
+	Philox4x32 rand(std::random_device{}());
+	for (int i = 0; i < 10000; ++i)
+	{
+		ReservoirSamplerWeighted<int, float, Philox4x32&> sampler(5, rand);
+
+		for (int n = 0; n < 20; ++n)
+		{
+			sampler.sampleElement(1.0f, n);
+		}
+
+		const auto [data, size] = sampler.getResult();
+		for (size_t k = 0; k < size; ++k)
+		{
+			++frequences[data[k]];
+		}
+	}
+
+	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
+	ASSERT_EQ(5.0f * 10000, frequencySum);
+	for (int freq : frequences)
+	{
+		EXPECT_NEAR(0.05f, freq/frequencySum, 0.01f);
+	}
+}
@@ -5,6 +5,7 @@
 #include <array>
 #include <numeric>
 
+#include "MonteCarloTrials.h"
 #include "TestTypes.h"
 
 TEST(ReservoirSampler, SamplersOfDifferentTypes_CreeateFillAndDestroy_DoNotCrash)
@@ -374,10 +375,7 @@ TEST(ReservoirSampler, Sampler_Moved_OldSamplerCanBeReused)
 
 TEST(ReservoirSampler, SamplerSizeOfFive_SamplingFromStreamOfTwenty_ProducesEqualFrequencies)
 {
-	std::array<int, 20> frequences{};
-	// reuse random to speed things up a bit
-	std::mt19937 rand{std::random_device{}()};
-	for (int i = 0; i < 10000; ++i)
+	const std::array<int, 20> frequences = runParallelTrials<std::array<int, 20>>(10000, [](std::mt19937& rand, std::array<int, 20>& trialFrequences)
 	{
 		ReservoirSampler<int, std::mt19937&> sampler(5, rand);
 
@@ -391,9 +389,9 @@ TEST(ReservoirSampler, SamplerSizeOfFive_SamplingFromStreamOfTwenty_ProducesEqua
 
 		for (int item : samplerMoved.getResult())
 		{
-			++frequences[item];
+			++trialFrequences[item];
 		}
-	}
+	});
 
 	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
 	ASSERT_EQ(5.0f * 10000, frequencySum);
@@ -405,10 +403,7 @@ TEST(ReservoirSampler, SamplerSizeOfFive_SamplingFromStreamOfTwenty_ProducesEqua
 
 TEST(ReservoirSampler, Sampler_AddingWhenWillBeConsidered_ProducesEqualFrequencies)
 {
-	std::array<int, 20> frequences{};
-	// reuse random to speed things up a bit
-	std::mt19937 rand{std::random_device{}()};
-	for (int i = 0; i < 10000; ++i)
+	const std::array<int, 20> frequences = runParallelTrials<std::array<int, 20>>(10000, [](std::mt19937& rand, std::array<int, 20>& trialFrequences)
 	{
 		ReservoirSampler<int, std::mt19937&> sampler(5, rand);
 
@@ -429,9 +424,9 @@ TEST(ReservoirSampler, Sampler_AddingWhenWillBeConsidered_ProducesEqualFrequenci
 
 		for (int item : samplerMoved.getResult())
 		{
-			++frequences[item];
+			++trialFrequences[item];
 		}
-	}
+	});
 
 	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
 	ASSERT_EQ(5.0f * 10000, frequencySum);
@@ -443,10 +438,7 @@ TEST(ReservoirSampler, Sampler_AddingWhenWillBeConsidered_ProducesEqualFrequenci
 
 TEST(ReservoirSampler, Sampler_JumpAheadWhenAdding_ProducesEqualFrequencies)
 {
-	std::array<int, 20> frequences{};
-	// reuse random to speed things up a bit
-	std::mt19937 rand{std::random_device{}()};
-	for (int i = 0; i < 10000; ++i)
+	const std::array<int, 20> frequences = runParallelTrials<std::array<int, 20>>(10000, [](std::mt19937& rand, std::array<int, 20>& trialFrequences)
 	{
 		ReservoirSampler<int, std::mt19937&> sampler(5, rand);
 
@@ -462,9 +454,9 @@ TEST(ReservoirSampler, Sampler_JumpAheadWhenAdding_ProducesEqualFrequencies)
 
 		for (int item : samplerMoved.getResult())
 		{
-			++frequences[item];
+			++trialFrequences[item];
 		}
-	}
+	});
 
 	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
 	ASSERT_EQ(5.0f * 10000, frequencySum);
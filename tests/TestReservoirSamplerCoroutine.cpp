@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+
+#include "sampler-extensions/reservoir_sampler_coroutine.h"
+
+#if defined(__cpp_impl_coroutine) && defined(__cpp_lib_coroutine)
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <string>
+
+#include "reservoir-sampler/reservoir_sampler.h"
+
+#include "MonteCarloTrials.h"
+
+namespace ReservoirSamplerCoroutineTestsInternal
+{
+	// eagerly started coroutine that doesn't produce any value
+	struct ProducerTask
+	{
+		struct promise_type
+		{
+			ProducerTask get_return_object() { return {}; }
+			std::suspend_never initial_suspend() noexcept { return {}; }
+			std::suspend_never final_suspend() noexcept { return {}; }
+			void return_void() noexcept {}
+			void unhandled_exception() { std::terminate(); }
+		};
+	};
+
+	template<typename Sink>
+	ProducerTask produceRange(Sink& sink, int begin, int end, int& acceptedCount)
+	{
+		for (int n = begin; n < end; ++n)
+		{
+			if (co_await sink.push(n))
+			{
+				++acceptedCount;
+			}
+		}
+	}
+
+	struct ConstructionCounter
+	{
+		explicit ConstructionCounter(int value, int& constructionsCount)
+			: value(value)
+		{
+			++constructionsCount;
+		}
+
+		int value;
+	};
+
+	template<typename Sink>
+	ProducerTask produceConstructionCounters(Sink& sink, int count, int& constructionsCount)
+	{
+		for (int n = 0; n < count; ++n)
+		{
+			co_await sink.pushEmplace(n, constructionsCount);
+		}
+	}
+}
+
+TEST(ReservoirSamplerCoroutine, SinkOfSamplerOfSizeFive_FiveElementsPushed_AllElementsAccepted)
+{
+	using namespace ReservoirSamplerCoroutineTestsInternal;
+
+	ReservoirSampler<int> sampler(5);
+	SamplerSink sink(sampler);
+
+	int acceptedCount = 0;
+	produceRange(sink, 10, 15, acceptedCount);
+
+	EXPECT_EQ(5, acceptedCount);
+
+	std::vector<int> result;
+	for (int value : sink.results())
+	{
+		result.push_back(value);
+	}
+	std::sort(result.begin(), result.end());
+	EXPECT_EQ(std::vector<int>({10, 11, 12, 13, 14}), result);
+	EXPECT_EQ(static_cast<size_t>(0), sampler.getResultSize());
+}
+
+TEST(ReservoirSamplerCoroutine, SinkOfSamplerOfSizeFive_GeneratorOutlivesSinkAndSampler_YieldsAllElements)
+{
+	using namespace ReservoirSamplerCoroutineTestsInternal;
+
+	std::optional<SampleGenerator<int>> generator;
+	{
+		ReservoirSampler<int> sampler(5);
+		SamplerSink sink(sampler);
+
+		int acceptedCount = 0;
+		produceRange(sink, 10, 15, acceptedCount);
+
+		generator.emplace(sink.results());
+		// the result is consumed before the generator is started
+		EXPECT_EQ(static_cast<size_t>(0), sampler.getResultSize());
+	}
+
+	std::vector<int> result;
+	for (int value : *generator)
+	{
+		result.push_back(value);
+	}
+	std::sort(result.begin(), result.end());
+	EXPECT_EQ(std::vector<int>({10, 11, 12, 13, 14}), result);
+}
+
+TEST(ReservoirSamplerCoroutine, SinkOfSamplerOfStrings_ElementsPushed_GeneratorYieldsStrings)
+{
+	ReservoirSampler<std::string> sampler(2);
+	SamplerSink sink(sampler);
+
+	[](SamplerSink<ReservoirSampler<std::string>>& sink) -> ReservoirSamplerCoroutineTestsInternal::ProducerTask
+	{
+		const std::string value = "test";
+		co_await sink.push(value);
+		co_await sink.push(std::string("test"));
+	}(sink);
+
+	size_t resultSize = 0;
+	for (const std::string& value : sink.results())
+	{
+		EXPECT_EQ("test", value);
+		++resultSize;
+	}
+	EXPECT_EQ(static_cast<size_t>(2), resultSize);
+}
+
+TEST(ReservoirSamplerCoroutine, SinkOfSamplerOfSizeFive_LongStreamEmplaced_RejectedElementsAreNotConstructed)
+{
+	using namespace ReservoirSamplerCoroutineTestsInternal;
+
+	ReservoirSampler<ConstructionCounter> sampler(5);
+	SamplerSink sink(sampler);
+
+	int constructionsCount = 0;
+	produceConstructionCounters(sink, 100000, constructionsCount);
+
+	EXPECT_EQ(static_cast<size_t>(5), sampler.getResultSize());
+	EXPECT_LT(constructionsCount, 1000);
+}
+
+TEST(ReservoirSamplerCoroutine, SinkOfSamplerOfSizeFive_TwoProducers_ProducesEqualFrequencies)
+{
+	using namespace ReservoirSamplerCoroutineTestsInternal;
+
+	const std::array<int, 20> frequences = runParallelTrials<std::array<int, 20>>(10000, [](std::mt19937& rand, std::array<int, 20>& trialFrequences)
+	{
+		ReservoirSampler<int, std::mt19937&> sampler(5, rand);
+		SamplerSink sink(sampler);
+
+		int acceptedCount = 0;
+		produceRange(sink, 0, 10, acceptedCount);
+		produceRange(sink, 10, 20, acceptedCount);
+
+		for (int item : sink.results())
+		{
+			++trialFrequences[item];
+		}
+	});
+
+	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
+	ASSERT_EQ(5.0f * 10000, frequencySum);
+	for (int freq : frequences)
+	{
+		EXPECT_NEAR(0.05f, freq/frequencySum, 0.01f);
+	}
+}
+
+#endif // __cpp_impl_coroutine && __cpp_lib_coroutine
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include "sampler-extensions/reservoir_sampler_decayed.h"
+
+#include <array>
+#include <numeric>
+
+#include "MonteCarloTrials.h"
+
+TEST(ReservoirSamplerDecayed, SamplerOfSizeFive_ThreeElementsAdded_HasOnlyOriginalElements)
+{
+	const std::vector<size_t> stream({10, 11, 12});
+
+	ReservoirSamplerDecayed<size_t> sampler(5, 0.1);
+	for (size_t i = 0; i < stream.size(); ++i)
+	{
+		sampler.sampleElement(static_cast<double>(i), stream[i]);
+	}
+
+	std::vector<size_t> result = sampler.consumeResult();
+	std::sort(result.begin(), result.end());
+	EXPECT_EQ(stream, result);
+	EXPECT_EQ(static_cast<size_t>(0), sampler.getResultSize());
+}
+
+TEST(ReservoirSamplerDecayed, SamplerWithAResult_Reset_CanBeReused)
+{
+	ReservoirSamplerDecayed<std::string> sampler(2, 1.0);
+	sampler.sampleElement(1.0, "test");
+	sampler.sampleElementEmplace(2.0, 3, 'a');
+
+	sampler.reset();
+	EXPECT_EQ(static_cast<size_t>(0), sampler.getResultSize());
+
+	sampler.sampleElement(100.0, "test2");
+	EXPECT_EQ(std::vector<std::string>({"test2"}), sampler.getResult());
+	EXPECT_EQ(100.0, sampler.getLandmark());
+}
+
+TEST(ReservoirSamplerDecayed, SamplerSizeOfOne_SamplingFromDecayedStream_ProducesExpectedFrequencies)
+{
+	// weights double with every time unit: 1, 2, 4, 8, 16
+	constexpr size_t elementsCount = 5;
+	const double decayRate = std::log(2.0);
+
+	const std::array<int, elementsCount> frequences = runParallelTrials<std::array<int, elementsCount>>(100000, [&decayRate](std::mt19937& rand, std::array<int, elementsCount>& trialFrequences)
+	{
+		ReservoirSamplerDecayed<size_t, std::mt19937&> sampler(1, decayRate, rand);
+
+		for (size_t n = 0; n < elementsCount; ++n)
+		{
+			sampler.sampleElement(static_cast<double>(n), n);
+		}
+
+		for (size_t item : sampler.getResult())
+		{
+			++trialFrequences[item];
+		}
+	});
+
+	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
+	ASSERT_EQ(100000.0f, frequencySum);
+	for (size_t n = 0; n < elementsCount; ++n)
+	{
+		EXPECT_NEAR(static_cast<float>(1 << n) / 31.0f, frequences[n]/frequencySum, 0.01f);
+	}
+}
+
+TEST(ReservoirSamplerDecayed, SamplerWithLongRunningStream_LandmarkMoved_KeepsExpectedFrequencies)
+{
+	const std::array<int, 2> frequences = runParallelTrials<std::array<int, 2>>(100000, [](std::mt19937& rand, std::array<int, 2>& trialFrequences)
+	{
+		ReservoirSamplerDecayed<int, std::mt19937&> sampler(1, 1.0, rand);
+
+		// exp(1e6) doesn't fit into a double, the landmark has to be moved
+		sampler.sampleElement(0.0, -1);
+		sampler.sampleElement(1000000.0, 0);
+		sampler.sampleElement(1000000.0 + std::log(3.0), 1);
+
+		for (int item : sampler.getResult())
+		{
+			ASSERT_LE(0, item);
+			++trialFrequences[static_cast<size_t>(item)];
+		}
+	});
+
+	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
+	ASSERT_EQ(100000.0f, frequencySum);
+	EXPECT_NEAR(0.25f, frequences[0]/frequencySum, 0.01f);
+	EXPECT_NEAR(0.75f, frequences[1]/frequencySum, 0.01f);
+}
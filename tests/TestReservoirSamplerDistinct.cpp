@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include "sampler-extensions/reservoir_sampler_distinct.h"
+
+#include <array>
+#include <numeric>
+#include <random>
+#include <string>
+
+#include "MonteCarloTrials.h"
+
+TEST(ReservoirSamplerDistinct, SamplerOfSizeFive_ThreeDistinctValuesRepeated_HasEachValueOnce)
+{
+	ReservoirSamplerDistinct<std::string> sampler(5);
+	for (int i = 0; i < 100; ++i)
+	{
+		sampler.sampleElement("first");
+		sampler.sampleElement(i % 10 == 0 ? "second" : "first");
+		sampler.sampleElement(std::string("third"));
+	}
+
+	std::vector<std::string> result = sampler.consumeResult();
+	std::sort(result.begin(), result.end());
+	EXPECT_EQ(std::vector<std::string>({"first", "second", "third"}), result);
+	EXPECT_EQ(static_cast<size_t>(0), sampler.getResultSize());
+}
+
+TEST(ReservoirSamplerDistinct, SamplersWithTheSameSeed_StreamsInDifferentOrder_ProduceTheSameResult)
+{
+	ReservoirSamplerDistinct<int> sampler1(5, 42);
+	ReservoirSamplerDistinct<int> sampler2(5, 42);
+	for (int n = 0; n < 1000; ++n)
+	{
+		sampler1.sampleElement(n);
+		sampler2.sampleElement(999 - n);
+		sampler2.sampleElement(n % 7);
+	}
+
+	std::vector<int> result1 = sampler1.getResult();
+	std::vector<int> result2 = sampler2.getResult();
+	std::sort(result1.begin(), result1.end());
+	std::sort(result2.begin(), result2.end());
+	EXPECT_EQ(result1, result2);
+	EXPECT_EQ(static_cast<size_t>(5), result1.size());
+}
+
+TEST(ReservoirSamplerDistinct, SamplersWithAdjacentSeeds_ShiftedStreamsOfIntegers_ProduceUnrelatedResults)
+{
+	// the seed should not act as a shift of the identity hash of integers
+	ReservoirSamplerDistinct<int> sampler1(5, 0);
+	ReservoirSamplerDistinct<int> sampler2(5, 1);
+	for (int n = 0; n < 1000; ++n)
+	{
+		sampler1.sampleElement(n);
+		sampler2.sampleElement(n + 1);
+	}
+
+	std::vector<int> shiftedResult1 = sampler1.getResult();
+	for (int& value : shiftedResult1)
+	{
+		++value;
+	}
+	std::vector<int> result2 = sampler2.getResult();
+	std::sort(shiftedResult1.begin(), shiftedResult1.end());
+	std::sort(result2.begin(), result2.end());
+	EXPECT_NE(shiftedResult1, result2);
+}
+
+TEST(ReservoirSamplerDistinct, SamplerWithAResult_ValuesAboveThreshold_AreNotConsidered)
+{
+	ReservoirSamplerDistinct<int> sampler(3);
+	for (int n = 0; n < 100; ++n)
+	{
+		sampler.sampleElement(n);
+	}
+
+	for (int item : sampler.getResult())
+	{
+		EXPECT_TRUE(sampler.willElementBeConsidered(item));
+	}
+
+	int notConsideredCount = 0;
+	for (int n = 0; n < 100; ++n)
+	{
+		notConsideredCount += sampler.willElementBeConsidered(n) ? 0 : 1;
+	}
+	EXPECT_EQ(97, notConsideredCount);
+}
+
+TEST(ReservoirSamplerDistinct, SamplerOfSizeHundred_ManyDistinctValues_EstimatesDistinctCount)
+{
+	ReservoirSamplerDistinct<int> sampler(100);
+	for (int n = 0; n < 100000; ++n)
+	{
+		sampler.sampleElement(n % 20000);
+	}
+
+	// standard error of the estimate is about 1/sqrt(100) = 10%
+	EXPECT_NEAR(20000.0, sampler.estimateDistinctCount(), 20000.0 * 0.4);
+}
+
+TEST(ReservoirSamplerDistinct, SamplerSizeOfFive_SamplingFromStreamWithHeavyHitter_ProducesEqualFrequencies)
+{
+	const std::array<int, 20> frequences = runParallelTrials<std::array<int, 20>>(10000, [](std::mt19937& rand, std::array<int, 20>& trialFrequences)
+	{
+		// the value 0 appears much more often than others but shouldn't be sampled more often
+		ReservoirSamplerDistinct<int> sampler(5, rand());
+		for (int n = 0; n < 20; ++n)
+		{
+			sampler.sampleElement(n);
+			sampler.sampleElement(0);
+			sampler.sampleElement(0);
+		}
+
+		for (int item : sampler.getResult())
+		{
+			++trialFrequences[item];
+		}
+	});
+
+	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
+	ASSERT_EQ(5.0f * 10000, frequencySum);
+	for (int freq : frequences)
+	{
+		EXPECT_NEAR(0.05f, freq/frequencySum, 0.01f);
+	}
+}
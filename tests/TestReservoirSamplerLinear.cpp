@@ -5,6 +5,7 @@
 #include <array>
 #include <numeric>
 
+#include "MonteCarloTrials.h"
 #include "TestTypes.h"
 
 TEST(ReservoirSamplerLinear, SamplersOfDifferentTypes_CreeateFillAndDestroy_DoNotCrash)
@@ -304,10 +305,7 @@ TEST(ReservoirSamplerLinear, SamplersWithDifferentWeightTypes_FilledWithData_Pro
 
 TEST(ReservoirSamplerLinear, SamplerSizeOfFive_SamplingFromStreamOfTwenty_ProducesEqualFrequencies)
 {
-	std::array<int, 20> frequences{};
-	// reuse random to speed things up a bit
-	std::mt19937 rand{std::random_device{}()};
-	for (int i = 0; i < 10000; ++i)
+	const std::array<int, 20> frequences = runParallelTrials<std::array<int, 20>>(10000, [](std::mt19937& rand, std::array<int, 20>& trialFrequences)
 	{
 		ReservoirSamplerLinear<int, int, std::mt19937&> sampler(rand);
 
@@ -321,8 +319,8 @@ TEST(ReservoirSamplerLinear, SamplerSizeOfFive_SamplingFromStreamOfTwenty_Produc
 
 		const auto result = samplerMoved.getResult();
 		ASSERT_TRUE(result.has_value());
-		++frequences[*result];
-	}
+		++trialFrequences[*result];
+	});
 
 	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
 	ASSERT_EQ(10000, frequencySum);
@@ -350,10 +348,7 @@ TEST(ReservoirSamplerLinear, Sampler_SamplingFromStreamOfWeightedValues_Produces
 		expectedFrequencies[i] = weights[i] / weightSum;
 	}
 
-	std::array<int, elementsCount> frequences{};
-	// reuse random to speed things up a bit
-	std::mt19937 rand{std::random_device{}()};
-	for (int i = 0; i < 100000; ++i)
+	const std::array<int, elementsCount> frequences = runParallelTrials<std::array<int, elementsCount>>(100000, [&weights](std::mt19937& rand, std::array<int, elementsCount>& trialFrequences)
 	{
 		ReservoirSamplerLinear<size_t, int, std::mt19937&> sampler(rand);
 
@@ -369,9 +364,9 @@ TEST(ReservoirSamplerLinear, Sampler_SamplingFromStreamOfWeightedValues_Produces
 		ASSERT_TRUE(result.has_value());
 #pragma GCC diagnostic push // GCC 11 complains about this line and it doesn't make sense, ignore
 #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
-		++frequences[*result];
+		++trialFrequences[*result];
 #pragma GCC diagnostic pop
-	}
+	});
 
 	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
 	for (size_t i = 0; i < elementsCount; ++i)
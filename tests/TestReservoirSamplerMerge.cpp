@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include "reservoir-sampler/reservoir_sampler.h"
+#include "sampler-extensions/reservoir_sampler_merge.h"
+
+#include <array>
+#include <numeric>
+
+#include "MonteCarloTrials.h"
+
+TEST(ReservoirSamplerMerge, SamplesSmallerThanSampleSize_Merged_HaveAllElements)
+{
+	std::mt19937 rand{std::random_device{}()};
+	std::vector<std::vector<int>> samples{{1, 2}, {}, {3}, {4, 5}};
+
+	std::vector<int> result = mergeUniformSamples(samples, {2, 0, 1, 2}, 10, rand);
+	std::sort(result.begin(), result.end());
+	EXPECT_EQ(std::vector<int>({1, 2, 3, 4, 5}), result);
+}
+
+TEST(ReservoirSamplerMerge, SamplersOfUnequalParts_Merged_ProduceEqualFrequencies)
+{
+	// parts of sizes 2, 15 and 3 of a stream of twenty elements
+	const std::array<std::pair<int, int>, 3> parts{{{0, 2}, {2, 17}, {17, 20}}};
+
+	const std::array<int, 20> frequences = runParallelTrials<std::array<int, 20>>(10000, [&parts](std::mt19937& rand, std::array<int, 20>& trialFrequences)
+	{
+		std::vector<std::vector<int>> samples;
+		std::vector<uint64_t> populationSizes;
+		for (const auto& [begin, end] : parts)
+		{
+			ReservoirSampler<int, std::mt19937&> sampler(5, rand);
+			for (int n = begin; n < end; ++n)
+			{
+				sampler.sampleElement(n);
+			}
+			samples.push_back(sampler.consumeResult());
+			populationSizes.push_back(static_cast<uint64_t>(end - begin));
+		}
+
+		const std::vector<int> result = mergeUniformSamples(samples, populationSizes, 5, rand);
+		ASSERT_EQ(static_cast<size_t>(5), result.size());
+		for (int item : result)
+		{
+			++trialFrequences[item];
+		}
+	});
+
+	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
+	ASSERT_EQ(5.0f * 10000, frequencySum);
+	for (int freq : frequences)
+	{
+		EXPECT_NEAR(0.05f, freq/frequencySum, 0.01f);
+	}
+}
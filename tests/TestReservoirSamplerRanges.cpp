@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include "sampler-extensions/reservoir_sampler_ranges.h"
+
+#if defined(__cpp_concepts) && defined(__cpp_lib_ranges)
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <random>
+#include <string>
+
+#include "MonteCarloTrials.h"
+
+TEST(ReservoirSamplerRanges, SampleOfFive_VectorOfFiveElementsPiped_ReturnsAllElements)
+{
+	const std::vector<int> data({10, 11, 12, 13, 14});
+	std::mt19937 rand{std::random_device{}()};
+
+	std::vector<int> result = data | views::reservoir_sample(5, rand);
+
+	std::sort(result.begin(), result.end());
+	EXPECT_EQ(data, result);
+}
+
+TEST(ReservoirSamplerRanges, SampleOfFive_FilteredRangePiped_ReturnsElementsFromTheFilteredRange)
+{
+	const std::vector<int> data({1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16});
+
+	const std::vector<int> result = data
+		| std::views::filter([](int value){ return value % 2 == 0; })
+		| views::reservoir_sample(5);
+
+	ASSERT_EQ(static_cast<size_t>(5), result.size());
+	for (int value : result)
+	{
+		EXPECT_EQ(0, value % 2);
+	}
+}
+
+TEST(ReservoirSamplerRanges, SampleOfThree_RangeOfStrings_ReturnsStrings)
+{
+	const std::array<std::string, 4> data{"a", "b", "c", "d"};
+	std::mt19937 rand{std::random_device{}()};
+
+	const std::vector<std::string> result = views::reservoir_sample(data, 3, rand);
+
+	ASSERT_EQ(static_cast<size_t>(3), result.size());
+	for (const std::string& value : result)
+	{
+		EXPECT_NE(std::find(data.begin(), data.end(), value), data.end());
+	}
+}
+
+TEST(ReservoirSamplerRanges, SampleOfFive_LargeRandomAccessRange_SkippedElementsAreNotAccessed)
+{
+	std::mt19937 rand{std::random_device{}()};
+	size_t accessedElementsCount = 0;
+
+	const std::vector<int> result = std::views::iota(0, 100000)
+		| std::views::transform([&accessedElementsCount](int value){ ++accessedElementsCount; return value; })
+		| views::reservoir_sample(5, rand);
+
+	EXPECT_EQ(static_cast<size_t>(5), result.size());
+	EXPECT_LT(accessedElementsCount, static_cast<size_t>(1000));
+}
+
+TEST(ReservoirSamplerRanges, SampleOfFive_OneClosureAppliedTwice_ReturnsDifferentSamples)
+{
+	const auto sampleFive = views::reservoir_sample(5);
+
+	const std::vector<int> firstResult = std::views::iota(0, 100000) | sampleFive;
+	const std::vector<int> secondResult = std::views::iota(0, 100000) | sampleFive;
+
+	ASSERT_EQ(static_cast<size_t>(5), firstResult.size());
+	ASSERT_EQ(static_cast<size_t>(5), secondResult.size());
+	EXPECT_NE(firstResult, secondResult);
+}
+
+TEST(ReservoirSamplerRanges, SamplerOfSizeFive_TwoRangesSampledInSequence_SamplesFromBothRanges)
+{
+	std::mt19937 rand{std::random_device{}()};
+	ReservoirSampler<int, std::mt19937&> sampler(5, rand);
+
+	sampleRange(std::views::iota(0, 5), sampler);
+	sampleRange(std::views::iota(5, 10), sampler);
+
+	std::vector<int> result = sampler.consumeResult();
+	ASSERT_EQ(static_cast<size_t>(5), result.size());
+	std::sort(result.begin(), result.end());
+	EXPECT_TRUE(std::adjacent_find(result.begin(), result.end()) == result.end());
+}
+
+TEST(ReservoirSamplerRanges, SampleOfFive_RandomAccessRangeOfTwenty_ProducesEqualFrequencies)
+{
+	const std::array<int, 20> frequences = runParallelTrials<std::array<int, 20>>(10000, [](std::mt19937& rand, std::array<int, 20>& trialFrequences)
+	{
+		for (int item : std::views::iota(0, 20) | views::reservoir_sample(5, rand))
+		{
+			++trialFrequences[item];
+		}
+	});
+
+	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
+	ASSERT_EQ(5.0f * 10000, frequencySum);
+	for (int freq : frequences)
+	{
+		EXPECT_NEAR(0.05f, freq/frequencySum, 0.01f);
+	}
+}
+
+TEST(ReservoirSamplerRanges, SampleOfFive_InputRangeOfTwenty_ProducesEqualFrequencies)
+{
+	const std::array<int, 20> frequences = runParallelTrials<std::array<int, 20>>(10000, [](std::mt19937& rand, std::array<int, 20>& trialFrequences)
+	{
+		auto inputRange = std::views::iota(0, 20) | std::views::filter([](int){ return true; });
+		for (int item : inputRange | views::reservoir_sample(5, rand))
+		{
+			++trialFrequences[item];
+		}
+	});
+
+	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
+	ASSERT_EQ(5.0f * 10000, frequencySum);
+	for (int freq : frequences)
+	{
+		EXPECT_NEAR(0.05f, freq/frequencySum, 0.01f);
+	}
+}
+
+#endif // __cpp_concepts && __cpp_lib_ranges
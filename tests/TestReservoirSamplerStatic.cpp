@@ -5,6 +5,7 @@
 #include <array>
 #include <numeric>
 
+#include "MonteCarloTrials.h"
 #include "TestTypes.h"
 
 TEST(ReservoirSamplerStatic, SamplersOfDifferentTypes_CreeateFillAndDestroy_DoNotCrash)
@@ -462,10 +463,7 @@ TEST(ReservoirSamplerStatic, Sampler_MoveAssigned_OldSamplerCanBeReused)
 
 TEST(ReservoirSamplerStatic, SamplerSizeOfFive_SamplingFromStreamOfTwenty_ProducesEqualFrequencies)
 {
-	std::array<int, 20> frequences{};
-	// reuse random to speed things up a bit
-	std::mt19937 rand{std::random_device{}()};
-	for (int i = 0; i < 10000; ++i)
+	const std::array<int, 20> frequences = runParallelTrials<std::array<int, 20>>(10000, [](std::mt19937& rand, std::array<int, 20>& trialFrequences)
 	{
 		ReservoirSamplerStatic<int, 5, std::mt19937&> sampler(rand);
 
@@ -480,9 +478,9 @@ TEST(ReservoirSamplerStatic, SamplerSizeOfFive_SamplingFromStreamOfTwenty_Produc
 		const auto [data, size] = samplerMoved.getResult();
 		for (size_t k = 0; k < size; ++k)
 		{
-			++frequences[data[k]];
+			++trialFrequences[data[k]];
 		}
-	}
+	});
 
 	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
 	ASSERT_EQ(5.0f * 10000, frequencySum);
@@ -494,10 +492,7 @@ TEST(ReservoirSamplerStatic, SamplerSizeOfFive_SamplingFromStreamOfTwenty_Produc
 
 TEST(ReservoirSamplerStatic, Sampler_AddingWhenWillBeConsidered_ProducesEqualFrequencies)
 {
-	std::array<int, 20> frequences{};
-	// reuse random to speed things up a bit
-	std::mt19937 rand{std::random_device{}()};
-	for (int i = 0; i < 10000; ++i)
+	const std::array<int, 20> frequences = runParallelTrials<std::array<int, 20>>(10000, [](std::mt19937& rand, std::array<int, 20>& trialFrequences)
 	{
 		ReservoirSamplerStatic<int, 5, std::mt19937&> sampler(rand);
 
@@ -519,9 +514,9 @@ TEST(ReservoirSamplerStatic, Sampler_AddingWhenWillBeConsidered_ProducesEqualFre
 		const auto [data, size] = samplerMoved.getResult();
 		for (size_t k = 0; k < size; ++k)
 		{
-			++frequences[data[k]];
+			++trialFrequences[data[k]];
 		}
-	}
+	});
 
 	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
 	ASSERT_EQ(5.0f * 10000, frequencySum);
@@ -533,10 +528,7 @@ TEST(ReservoirSamplerStatic, Sampler_AddingWhenWillBeConsidered_ProducesEqualFre
 
 TEST(ReservoirSamplerStatic, Sampler_JumpAheadWhenAdding_ProducesEqualFrequencies)
 {
-	std::array<int, 20> frequences{};
-	// reuse random to speed things up a bit
-	std::mt19937 rand{std::random_device{}()};
-	for (int i = 0; i < 10000; ++i)
+	const std::array<int, 20> frequences = runParallelTrials<std::array<int, 20>>(10000, [](std::mt19937& rand, std::array<int, 20>& trialFrequences)
 	{
 		ReservoirSamplerStatic<int, 5, std::mt19937&> sampler(rand);
 
@@ -553,9 +545,9 @@ TEST(ReservoirSamplerStatic, Sampler_JumpAheadWhenAdding_ProducesEqualFrequencie
 		const auto [data, size] = samplerMoved.getResult();
 		for (size_t k = 0; k < size; ++k)
 		{
-			++frequences[data[k]];
+			++trialFrequences[data[k]];
 		}
-	}
+	});
 
 	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
 	ASSERT_EQ(5.0f * 10000, frequencySum);
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include "reservoir-sampler/reservoir_sampler_static.h"
+#include "sampler-extensions/reservoir_sampler_static_constexpr.h"
+
+#include <array>
+#include <numeric>
+#include <random>
+
+#include "MonteCarloTrials.h"
+
+namespace
+{
+	template<size_t SampleSize>
+	constexpr ReservoirSamplerStaticConstexpr<int, SampleSize> sampleRange(int streamSize, uint64_t seed)
+	{
+		ReservoirSamplerStaticConstexpr<int, SampleSize> sampler{SplitMix64(seed)};
+		for (int n = 0; n < streamSize; ++n)
+		{
+			sampler.sampleElement(n);
+		}
+		return sampler;
+	}
+
+	template<size_t SampleSize>
+	constexpr bool areAllInRangeAndUnique(const ReservoirSamplerStaticConstexpr<int, SampleSize>& sampler, int streamSize)
+	{
+		const auto result = sampler.getResult();
+		for (size_t i = 0; i < result.size; ++i)
+		{
+			if (result.data[i] < 0 || result.data[i] >= streamSize)
+			{
+				return false;
+			}
+
+			for (size_t j = i + 1; j < result.size; ++j)
+			{
+				if (result.data[i] == result.data[j])
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	constexpr bool isCopyOfNonConstSamplerEqual()
+	{
+		ReservoirSamplerStaticConstexpr<int, 5> sampler = sampleRange<5>(100, 3);
+		const ReservoirSamplerStaticConstexpr<int, 5> copy(sampler);
+		if (copy.getResultSize() != sampler.getResultSize() || copy.getProcessedElementsCount() != sampler.getProcessedElementsCount())
+		{
+			return false;
+		}
+
+		for (size_t i = 0; i < sampler.getResultSize(); ++i)
+		{
+			if (copy.getResult().data[i] != sampler.getResult().data[i])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	constexpr bool isDefaultSamplerSeededWithZero()
+	{
+		ReservoirSamplerStaticConstexpr<int, 5> sampler;
+		for (int n = 0; n < 100; ++n)
+		{
+			sampler.sampleElement(n);
+		}
+
+		const ReservoirSamplerStaticConstexpr<int, 5> seededSampler = sampleRange<5>(100, 0);
+		for (size_t i = 0; i < sampler.getResultSize(); ++i)
+		{
+			if (sampler.getResult().data[i] != seededSampler.getResult().data[i])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	constexpr bool isBoundedRandomInRange()
+	{
+		SplitMix64 rand(7);
+		for (uint64_t bound = 1; bound < 1000; ++bound)
+		{
+			if (getBoundedRandom(rand, bound) >= bound)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+// the whole sampling happens at compile time
+static_assert(SplitMix64(0)() == 0xE220A8397B1DCDAFull, "SplitMix64 should produce the reference sequence");
+static_assert(isBoundedRandomInRange(), "Bounded random numbers should be within the bounds");
+static_assert(sampleRange<5>(3, 1).getResultSize() == 3, "All elements should be taken while the sampler is not full");
+static_assert(sampleRange<5>(3, 1).getResult().data[2] == 2, "Elements should be stored in order while the sampler is not full");
+static_assert(sampleRange<5>(1000, 1).getResultSize() == 5, "The sampler should be full");
+static_assert(sampleRange<5>(1000, 1).getProcessedElementsCount() == 1000, "All the elements should be counted");
+static_assert(areAllInRangeAndUnique(sampleRange<5>(1000, 1), 1000), "Sampled elements should come from the stream");
+static_assert(areAllInRangeAndUnique(sampleRange<16>(100, 42), 100), "Sampled elements should come from the stream");
+static_assert(isCopyOfNonConstSamplerEqual(), "Copying a non-const sampler should use the copy constructor");
+static_assert(isDefaultSamplerSeededWithZero(), "A default constructed sampler should use the generator seeded with 0");
+
+TEST(ReservoirSamplerStaticConstexpr, SamplerWithAResult_Reset_CanBeReused)
+{
+	ReservoirSamplerStaticConstexpr<size_t, 5> sampler;
+	for (size_t value = 0; value < 20; ++value)
+	{
+		sampler.sampleElement(value);
+	}
+
+	sampler.reset();
+	EXPECT_EQ(static_cast<size_t>(0), sampler.getResultSize());
+
+	sampler.sampleElement(42);
+	ASSERT_EQ(static_cast<size_t>(1), sampler.getResultSize());
+	EXPECT_EQ(static_cast<size_t>(42), sampler.getResult().data[0]);
+}
+
+TEST(ReservoirSamplerStaticConstexpr, SamplerSizeOfFive_SamplingFromStreamOfTwenty_ProducesEqualFrequencies)
+{
+	const std::array<int, 20> frequences = runParallelTrials<std::array<int, 20>>(10000, [](std::mt19937& rand, std::array<int, 20>& trialFrequences)
+	{
+		ReservoirSamplerStaticConstexpr<int, 5> sampler{SplitMix64(rand())};
+
+		for (int n = 0; n < 20; ++n)
+		{
+			sampler.sampleElement(n);
+		}
+
+		for (int item : sampler.getResult())
+		{
+			++trialFrequences[item];
+		}
+	});
+
+	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
+	ASSERT_EQ(5.0f * 10000, frequencySum);
+	for (int freq : frequences)
+	{
+		EXPECT_NEAR(0.05f, freq/frequencySum, 0.01f);
+	}
+}
+
+TEST(ReservoirSamplerStaticConstexpr, ConstexprGenerator_UsedWithReservoirSamplerStatic_ProducesExpectedResult)
+{
+	const std::vector<int> stream({10, 11, 12, 13, 14});
+
+	ReservoirSamplerStatic<int, 5, SplitMix64> sampler(SplitMix64(42));
+	for (const int value : stream)
+	{
+		sampler.sampleElement(value);
+	}
+
+	std::vector<int> result = sampler.consumeResult();
+	std::sort(result.begin(), result.end());
+	EXPECT_EQ(stream, result);
+}
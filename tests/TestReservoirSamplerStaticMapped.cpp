@@ -0,0 +1,213 @@
+#include <gtest/gtest.h>
+
+#include "sampler-extensions/reservoir_sampler_static_mapped.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <thread>
+
+#include "MonteCarloTrials.h"
+
+namespace
+{
+	class ScopedTempFile
+	{
+	public:
+		explicit ScopedTempFile(const char* name)
+			: mPath(std::filesystem::temp_directory_path() / (std::string(name) + "." + std::to_string(::getpid())))
+		{
+			std::filesystem::remove(mPath);
+		}
+
+		~ScopedTempFile()
+		{
+			std::filesystem::remove(mPath);
+		}
+
+		std::string getPath() const { return mPath.string(); }
+
+	private:
+		std::filesystem::path mPath;
+	};
+}
+
+TEST(ReservoirSamplerStaticMapped, SamplerOfSizeFive_FiveElementsAdded_HasOnlyOriginalElements)
+{
+	ScopedTempFile file("rs_mapped_five_elements");
+	const std::vector<size_t> stream({10, 11, 12, 13, 14});
+
+	ReservoirSamplerStaticMapped<size_t, 5> sampler(file.getPath().c_str());
+	ASSERT_TRUE(sampler.isOpen());
+	for (const size_t value : stream)
+	{
+		sampler.sampleElement(value);
+	}
+
+	const auto [data, size] = sampler.getResult();
+	std::vector<size_t> result(data, data + size);
+	std::sort(result.begin(), result.end());
+	EXPECT_EQ(stream, result);
+}
+
+TEST(ReservoirSamplerStaticMapped, SamplerWithAResult_Reopened_ContinuesFromTheStoredState)
+{
+	ScopedTempFile file("rs_mapped_reopened");
+	const std::vector<size_t> stream1({10, 11, 12});
+	const std::vector<size_t> stream2({13, 14});
+
+	{
+		ReservoirSamplerStaticMapped<size_t, 5> sampler(file.getPath().c_str());
+		ASSERT_TRUE(sampler.isOpen());
+		for (const size_t value : stream1)
+		{
+			sampler.sampleElement(value);
+		}
+	}
+
+	ReservoirSamplerStaticMapped<size_t, 5> sampler(file.getPath().c_str());
+	ASSERT_TRUE(sampler.isOpen());
+	EXPECT_EQ(static_cast<uint64_t>(3), sampler.getProcessedElementsCount());
+	for (const size_t value : stream2)
+	{
+		sampler.sampleElement(value);
+	}
+
+	std::vector<size_t> result(sampler.getResult().begin(), sampler.getResult().end());
+	std::sort(result.begin(), result.end());
+	EXPECT_EQ(std::vector<size_t>({10, 11, 12, 13, 14}), result);
+}
+
+TEST(ReservoirSamplerStaticMapped, FileWithDifferentLayout_Opened_IsNotOpenAndFileIsKept)
+{
+	ScopedTempFile file("rs_mapped_different_layout");
+
+	{
+		ReservoirSamplerStaticMapped<int, 3> sampler(file.getPath().c_str());
+		ASSERT_TRUE(sampler.isOpen());
+		sampler.sampleElement(1);
+		sampler.sampleElement(2);
+	}
+
+	{
+		ReservoirSamplerStaticMapped<int, 5> sampler(file.getPath().c_str());
+		EXPECT_FALSE(sampler.isOpen());
+		EXPECT_EQ(static_cast<size_t>(0), sampler.getResultSize());
+	}
+
+	ReservoirSamplerStaticMapped<int, 3> sampler(file.getPath().c_str());
+	ASSERT_TRUE(sampler.isOpen());
+	std::vector<int> result(sampler.getResult().begin(), sampler.getResult().end());
+	std::sort(result.begin(), result.end());
+	EXPECT_EQ(std::vector<int>({1, 2}), result);
+}
+
+TEST(ReservoirSamplerStaticMapped, ForeignFileOfSameSize_Opened_IsNotOpenAndFileIsKept)
+{
+	using Sampler = ReservoirSamplerStaticMapped<size_t, 5>;
+	ScopedTempFile file("rs_mapped_foreign_same_size");
+	const std::string content(Sampler::FileSize, 'x');
+	{
+		std::ofstream stream(file.getPath(), std::ios::binary);
+		stream << content;
+	}
+
+	{
+		Sampler sampler(file.getPath().c_str());
+		EXPECT_FALSE(sampler.isOpen());
+	}
+
+	std::ifstream stream(file.getPath(), std::ios::binary);
+	EXPECT_EQ(content, std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()));
+}
+
+TEST(ReservoirSamplerStaticMapped, ForeignFileOfDifferentSize_Opened_IsNotOpenAndFileIsKept)
+{
+	ScopedTempFile file("rs_mapped_foreign_different_size");
+	const std::string content("not a sample");
+	{
+		std::ofstream stream(file.getPath(), std::ios::binary);
+		stream << content;
+	}
+
+	{
+		ReservoirSamplerStaticMapped<size_t, 5> sampler(file.getPath().c_str());
+		EXPECT_FALSE(sampler.isOpen());
+	}
+
+	EXPECT_EQ(content.size(), std::filesystem::file_size(file.getPath()));
+	std::ifstream stream(file.getPath(), std::ios::binary);
+	EXPECT_EQ(content, std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()));
+}
+
+TEST(ReservoirSamplerStaticMapped, SamplerWithAResult_Reset_CanBeReused)
+{
+	ScopedTempFile file("rs_mapped_reset");
+	ReservoirSamplerStaticMapped<size_t, 5> sampler(file.getPath().c_str());
+	ASSERT_TRUE(sampler.isOpen());
+
+	for (size_t value = 0; value < 20; ++value)
+	{
+		sampler.sampleElement(value);
+	}
+
+	sampler.reset();
+	EXPECT_EQ(static_cast<size_t>(0), sampler.getResultSize());
+
+	sampler.sampleElement(42);
+	ASSERT_EQ(static_cast<size_t>(1), sampler.getResultSize());
+	EXPECT_EQ(static_cast<size_t>(42), sampler.getResult().data[0]);
+	EXPECT_TRUE(sampler.flush());
+}
+
+TEST(ReservoirSamplerStaticMapped, FileInMissingDirectory_ElementsAdded_ResultIsEmpty)
+{
+	const std::filesystem::path filePath = std::filesystem::temp_directory_path() / "rs_mapped_missing_directory" / "sample";
+	ReservoirSamplerStaticMapped<size_t, 5> sampler(filePath.string().c_str());
+	ASSERT_FALSE(sampler.isOpen());
+
+	sampler.sampleElement(10);
+	sampler.reset();
+	sampler.sampleElement(11);
+
+	EXPECT_EQ(static_cast<size_t>(0), sampler.getResultSize());
+	EXPECT_EQ(static_cast<size_t>(0), sampler.getResult().size);
+	EXPECT_EQ(static_cast<uint64_t>(0), sampler.getProcessedElementsCount());
+	EXPECT_FALSE(sampler.flush());
+}
+
+TEST(ReservoirSamplerStaticMapped, SamplerSizeOfFive_SamplingFromStreamOfTwenty_ProducesEqualFrequencies)
+{
+	const std::array<int, 20> frequences = runParallelTrials<std::array<int, 20>>(10000, [](std::mt19937& rand, std::array<int, 20>& trialFrequences)
+	{
+		// every thread maps its own file once and reuses it for all its trials, the sampler is destroyed before the file
+		thread_local const ScopedTempFile file(("rs_mapped_frequencies." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()))).c_str());
+		thread_local ReservoirSamplerStaticMapped<int, 5> sampler(file.getPath().c_str(), rand());
+		ASSERT_TRUE(sampler.isOpen());
+		sampler.reset();
+
+		for (int n = 0; n < 20; ++n)
+		{
+			sampler.sampleElement(n);
+		}
+
+		for (int item : sampler.getResult())
+		{
+			++trialFrequences[item];
+		}
+	});
+
+	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
+	ASSERT_EQ(5.0f * 10000, frequencySum);
+	for (int freq : frequences)
+	{
+		EXPECT_NEAR(0.05f, freq/frequencySum, 0.01f);
+	}
+}
+
+#endif // defined(__unix__) || defined(__APPLE__)
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include "sampler-extensions/reservoir_sampler_stream_ordered.h"
+
+#include <array>
+#include <numeric>
+
+#include "MonteCarloTrials.h"
+
+TEST(ReservoirSamplerStreamOrdered, SamplerOfSizeFive_FiveElementsAdded_ReturnsThemInStreamOrder)
+{
+	const std::vector<int> stream({14, 10, 13, 11, 12});
+
+	ReservoirSamplerStreamOrdered<int> sampler(5);
+	for (const int value : stream)
+	{
+		sampler.sampleElement(value);
+	}
+
+	ReservoirSamplerStreamOrdered<int> samplerCopy(sampler);
+	EXPECT_EQ(stream, samplerCopy.consumeResult());
+
+	EXPECT_EQ(stream, sampler.consumeResult());
+	EXPECT_EQ(static_cast<size_t>(0), sampler.getResultSize());
+}
+
+TEST(ReservoirSamplerStreamOrdered, StaticSamplerOfSizeFive_LongStream_ReturnsResultInStreamOrder)
+{
+	ReservoirSamplerStaticStreamOrdered<std::string, 5> sampler;
+	for (int n = 0; n < 1000; ++n)
+	{
+		// values are decreasing, so the stream order is the opposite of the value order
+		sampler.sampleElement(std::to_string(100000 - n));
+	}
+
+	const std::vector<std::string> result = sampler.consumeResult();
+	ASSERT_EQ(static_cast<size_t>(5), result.size());
+	EXPECT_TRUE(std::is_sorted(result.begin(), result.end(), [](const std::string& left, const std::string& right){ return std::stoi(left) > std::stoi(right); }));
+}
+
+TEST(ReservoirSamplerStreamOrdered, LargeSampler_JumpAheadWhenAdding_ReturnsResultInStreamOrder)
+{
+	ReservoirSamplerStreamOrdered<size_t> sampler(5000);
+	for (size_t n = 0; n < 300000; ++n)
+	{
+		sampler.sampleElement(n);
+		const size_t skippedElementsCount = sampler.getNextSkippedElementsCount();
+		n += skippedElementsCount;
+		sampler.jumpAhead(skippedElementsCount);
+	}
+
+	const std::vector<size_t> result = sampler.consumeResult();
+	ASSERT_EQ(static_cast<size_t>(5000), result.size());
+	EXPECT_TRUE(std::is_sorted(result.begin(), result.end()));
+	EXPECT_TRUE(std::adjacent_find(result.begin(), result.end()) == result.end());
+}
+
+TEST(ReservoirSamplerStreamOrdered, ElementsWithPositionsOfDifferentMagnitude_GetStreamOrder_SortsByPosition)
+{
+	std::mt19937_64 rand{std::random_device{}()};
+	for (const size_t size : {10, 1000})
+	{
+		std::vector<StreamOrderedElement<int>> elements;
+		for (size_t i = 0; i < size; ++i)
+		{
+			elements.emplace_back(rand() >> (i % 64), static_cast<int>(i));
+		}
+
+		const std::vector<size_t> order = getStreamOrder(elements.data(), elements.size());
+		ASSERT_EQ(size, order.size());
+		for (size_t i = 1; i < order.size(); ++i)
+		{
+			EXPECT_LE(elements[order[i - 1]].position, elements[order[i]].position);
+		}
+	}
+}
+
+TEST(ReservoirSamplerStreamOrdered, SamplerSizeOfFive_SamplingFromStreamOfTwenty_ProducesEqualFrequencies)
+{
+	const std::array<int, 20> frequences = runParallelTrials<std::array<int, 20>>(10000, [](std::mt19937& rand, std::array<int, 20>& trialFrequences)
+	{
+		ReservoirSamplerStreamOrdered<int, std::mt19937&> sampler(5, rand);
+
+		for (int n = 0; n < 20; ++n)
+		{
+			if (sampler.willNextElementBeConsidered())
+			{
+				sampler.sampleElement(n);
+			}
+			else
+			{
+				sampler.skipNextElement();
+			}
+		}
+
+		const std::vector<int> result = sampler.consumeResult();
+		ASSERT_TRUE(std::is_sorted(result.begin(), result.end()));
+		for (int item : result)
+		{
+			++trialFrequences[item];
+		}
+	});
+
+	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
+	ASSERT_EQ(5.0f * 10000, frequencySum);
+	for (int freq : frequences)
+	{
+		EXPECT_NEAR(0.05f, freq/frequencySum, 0.01f);
+	}
+}
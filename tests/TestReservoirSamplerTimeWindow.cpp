@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include "sampler-extensions/reservoir_sampler_time_window.h"
+
+#include <array>
+#include <numeric>
+
+#include "MonteCarloTrials.h"
+
+namespace
+{
+	// manually controlled clock to make the tests independent from the real time
+	struct TestClock
+	{
+		using duration = std::chrono::milliseconds;
+		using rep = duration::rep;
+		using period = duration::period;
+		using time_point = std::chrono::time_point<TestClock>;
+		static constexpr bool is_steady = true;
+
+		static time_point now() { return time_point(duration(0)); }
+	};
+
+	TestClock::time_point atMs(int milliseconds)
+	{
+		return TestClock::time_point(std::chrono::milliseconds(milliseconds));
+	}
+}
+
+TEST(ReservoirSamplerTimeWindow, SamplerOfSizeFive_ThreeElementsAdded_HasOnlyOriginalElements)
+{
+	const std::vector<size_t> stream({10, 11, 12});
+
+	ReservoirSamplerTimeWindow<size_t, TestClock> sampler(5, std::chrono::milliseconds(100));
+	for (size_t i = 0; i < stream.size(); ++i)
+	{
+		sampler.sampleElementAt(atMs(static_cast<int>(i)), stream[i]);
+	}
+
+	std::vector<size_t> result = sampler.getResultAt(atMs(10));
+	std::sort(result.begin(), result.end());
+	EXPECT_EQ(stream, result);
+}
+
+TEST(ReservoirSamplerTimeWindow, SamplerWithOldElements_QueriedLater_ReturnsOnlyElementsInsideTheWindow)
+{
+	ReservoirSamplerTimeWindow<int, TestClock> sampler(5, std::chrono::milliseconds(100));
+	sampler.sampleElementAt(atMs(0), 1);
+	sampler.sampleElementAt(atMs(50), 2);
+	sampler.sampleElementAt(atMs(120), 3);
+
+	{
+		std::vector<int> result = sampler.getResultAt(atMs(120));
+		std::sort(result.begin(), result.end());
+		EXPECT_EQ(std::vector<int>({2, 3}), result);
+	}
+
+	EXPECT_TRUE(sampler.getResultAt(atMs(1000)).empty());
+	EXPECT_EQ(static_cast<size_t>(0), sampler.getStoredElementsCount());
+}
+
+TEST(ReservoirSamplerTimeWindow, SamplerOfSizeFive_LongStream_StoresBoundedAmountOfElements)
+{
+	ReservoirSamplerTimeWindow<int, TestClock> sampler(5, std::chrono::milliseconds(1000000));
+	for (int n = 0; n < 100000; ++n)
+	{
+		sampler.sampleElementAt(atMs(n), n);
+	}
+
+	// expected amount is about 5 * ln(100000 / 5) that is around 50
+	EXPECT_GT(static_cast<size_t>(200), sampler.getStoredElementsCount());
+	EXPECT_EQ(static_cast<size_t>(5), sampler.getResultAt(atMs(100000)).size());
+}
+
+TEST(ReservoirSamplerTimeWindow, SamplerSizeOfFive_SamplingFromBurstyStream_ProducesEqualFrequenciesInsideTheWindow)
+{
+	// elements come in bursts: 10 elements at 0ms, 20 elements at 60ms, 10 elements at 130ms
+	// the window of 100ms at 150ms covers the last 30 elements
+	const std::array<int, 40> frequences = runParallelTrials<std::array<int, 40>>(10000, [](std::mt19937& rand, std::array<int, 40>& trialFrequences)
+	{
+		ReservoirSamplerTimeWindow<int, TestClock, std::mt19937&> sampler(5, std::chrono::milliseconds(100), rand);
+
+		for (int n = 0; n < 40; ++n)
+		{
+			const int timestamp = (n < 10) ? 0 : (n < 30 ? 60 : 130);
+			sampler.sampleElementAt(atMs(timestamp), n);
+		}
+
+		const std::vector<int> result = sampler.getResultAt(atMs(150));
+		ASSERT_EQ(static_cast<size_t>(5), result.size());
+		for (int item : result)
+		{
+			++trialFrequences[item];
+		}
+	});
+
+	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
+	ASSERT_EQ(5.0f * 10000, frequencySum);
+	for (int n = 0; n < 10; ++n)
+	{
+		EXPECT_EQ(0, frequences[n]);
+	}
+	for (int n = 10; n < 40; ++n)
+	{
+		EXPECT_NEAR(1.0f / 30.0f, frequences[n]/frequencySum, 0.01f);
+	}
+}
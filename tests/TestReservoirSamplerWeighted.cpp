@@ -5,6 +5,7 @@
 #include <array>
 #include <numeric>
 
+#include "MonteCarloTrials.h"
 #include "TestTypes.h"
 
 TEST(ReservoirSamplerWeighted, SamplersOfDifferentTypes_CreeateFillAndDestroy_DoNotCrash)
@@ -443,10 +444,7 @@ TEST(ReservoirSamplerWeighted, SamplersWithDifferentWeightTypes_FilledWithData_P
 
 TEST(ReservoirSamplerWeighted, SamplerSizeOfFive_SamplingFromStreamOfTwenty_ProducesEqualFrequencies)
 {
-	std::array<int, 20> frequences{};
-	// reuse random to speed things up a bit
-	std::mt19937 rand{std::random_device{}()};
-	for (int i = 0; i < 10000; ++i)
+	const std::array<int, 20> frequences = runParallelTrials<std::array<int, 20>>(10000, [](std::mt19937& rand, std::array<int, 20>& trialFrequences)
 	{
 		ReservoirSamplerWeighted<int, int, std::mt19937&> sampler(5, rand);
 
@@ -461,9 +459,9 @@ TEST(ReservoirSamplerWeighted, SamplerSizeOfFive_SamplingFromStreamOfTwenty_Prod
 		const auto [data, size] = samplerMoved.getResult();
 		for (size_t k = 0; k < size; ++k)
 		{
-			++frequences[data[k]];
+			++trialFrequences[data[k]];
 		}
-	}
+	});
 
 	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
 	ASSERT_EQ(5.0f * 10000, frequencySum);
@@ -475,10 +473,7 @@ TEST(ReservoirSamplerWeighted, SamplerSizeOfFive_SamplingFromStreamOfTwenty_Prod
 
 TEST(ReservoirSamplerWeighted, Sampler_AddingWhenWillBeConsidered_ProducesEqualFrequencies)
 {
-	std::array<int, 20> frequences{};
-	// reuse random to speed things up a bit
-	std::mt19937 rand{std::random_device{}()};
-	for (int i = 0; i < 10000; ++i)
+	const std::array<int, 20> frequences = runParallelTrials<std::array<int, 20>>(10000, [](std::mt19937& rand, std::array<int, 20>& trialFrequences)
 	{
 		ReservoirSamplerWeighted<int, int, std::mt19937&> sampler(5, rand);
 
@@ -500,9 +495,9 @@ TEST(ReservoirSamplerWeighted, Sampler_AddingWhenWillBeConsidered_ProducesEqualF
 		const auto [data, size] = samplerMoved.getResult();
 		for (size_t k = 0; k < size; ++k)
 		{
-			++frequences[data[k]];
+			++trialFrequences[data[k]];
 		}
-	}
+	});
 
 	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
 	ASSERT_EQ(5.0f * 10000, frequencySum);
@@ -530,10 +525,7 @@ TEST(ReservoirSamplerWeighted, SamplerSizeOfFive_SamplingFromStreamOfWeightedVal
 		expectedFrequencies[i] = weights[i] / weightSum;
 	}
 
-	std::array<int, elementsCount> frequences{};
-	// reuse random to speed things up a bit
-	std::mt19937 rand{std::random_device{}()};
-	for (int i = 0; i < 100000; ++i)
+	const std::array<int, elementsCount> frequences = runParallelTrials<std::array<int, elementsCount>>(100000, [&weights](std::mt19937& rand, std::array<int, elementsCount>& trialFrequences)
 	{
 		ReservoirSamplerWeighted<size_t, int, std::mt19937&> sampler(5, rand);
 
@@ -548,9 +540,9 @@ TEST(ReservoirSamplerWeighted, SamplerSizeOfFive_SamplingFromStreamOfWeightedVal
 		const auto [data, size] = samplerMoved.getResult();
 		for (size_t k = 0; k < size; ++k)
 		{
-			++frequences[data[k]];
+			++trialFrequences[data[k]];
 		}
-	}
+	});
 
 	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
 	for (size_t i = 0; i < elementsCount; ++i)
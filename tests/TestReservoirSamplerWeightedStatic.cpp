@@ -5,6 +5,7 @@
 #include <array>
 #include <numeric>
 
+#include "MonteCarloTrials.h"
 #include "TestTypes.h"
 
 TEST(ReservoirSamplerWeightedStatic, SamplersOfDifferentTypes_CreeateFillAndDestroy_DoNotCrash)
@@ -530,10 +531,7 @@ TEST(ReservoirSamplerWeightedStatic, SamplersWithDifferentWeightTypes_FilledWith
 
 TEST(ReservoirSamplerWeightedStatic, SamplerSizeOfFive_SamplingFromStreamOfTwenty_ProducesEqualFrequencies)
 {
-	std::array<int, 20> frequences{};
-	// reuse random to speed things up a bit
-	std::mt19937 rand{std::random_device{}()};
-	for (int i = 0; i < 10000; ++i)
+	const std::array<int, 20> frequences = runParallelTrials<std::array<int, 20>>(10000, [](std::mt19937& rand, std::array<int, 20>& trialFrequences)
 	{
 		ReservoirSamplerWeightedStatic<int, 5, int, std::mt19937&> sampler(rand);
 
@@ -548,9 +546,9 @@ TEST(ReservoirSamplerWeightedStatic, SamplerSizeOfFive_SamplingFromStreamOfTwent
 		const auto [data, size] = samplerMoved.getResult();
 		for (size_t k = 0; k < size; ++k)
 		{
-			++frequences[data[k]];
+			++trialFrequences[data[k]];
 		}
-	}
+	});
 
 	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
 	ASSERT_EQ(5.0f * 10000, frequencySum);
@@ -562,10 +560,7 @@ TEST(ReservoirSamplerWeightedStatic, SamplerSizeOfFive_SamplingFromStreamOfTwent
 
 TEST(ReservoirSamplerWeightedStatic, Sampler_AddingWhenWillBeConsidered_ProducesEqualFrequencies)
 {
-	std::array<int, 20> frequences{};
-	// reuse random to speed things up a bit
-	std::mt19937 rand{std::random_device{}()};
-	for (int i = 0; i < 10000; ++i)
+	const std::array<int, 20> frequences = runParallelTrials<std::array<int, 20>>(10000, [](std::mt19937& rand, std::array<int, 20>& trialFrequences)
 	{
 		ReservoirSamplerWeightedStatic<int, 5, int, std::mt19937&> sampler(rand);
 
@@ -587,9 +582,9 @@ TEST(ReservoirSamplerWeightedStatic, Sampler_AddingWhenWillBeConsidered_Produces
 		const auto [data, size] = samplerMoved.getResult();
 		for (size_t k = 0; k < size; ++k)
 		{
-			++frequences[data[k]];
+			++trialFrequences[data[k]];
 		}
-	}
+	});
 
 	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
 	ASSERT_EQ(5.0f * 10000, frequencySum);
@@ -617,10 +612,7 @@ TEST(ReservoirSamplerWeightedStatic, SamplerSizeOfFive_SamplingFromStreamOfWeigh
 		expectedFrequencies[i] = weights[i] / weightSum;
 	}
 
-	std::array<int, elementsCount> frequences{};
-	// reuse random to speed things up a bit
-	std::mt19937 rand{std::random_device{}()};
-	for (int i = 0; i < 100000; ++i)
+	const std::array<int, elementsCount> frequences = runParallelTrials<std::array<int, elementsCount>>(100000, [&weights](std::mt19937& rand, std::array<int, elementsCount>& trialFrequences)
 	{
 		ReservoirSamplerWeightedStatic<size_t, 5, int, std::mt19937&> sampler(rand);
 
@@ -635,9 +627,9 @@ TEST(ReservoirSamplerWeightedStatic, SamplerSizeOfFive_SamplingFromStreamOfWeigh
 		const auto [data, size] = samplerMoved.getResult();
 		for (size_t k = 0; k < size; ++k)
 		{
-			++frequences[data[k]];
+			++trialFrequences[data[k]];
 		}
-	}
+	});
 
 	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
 	for (size_t i = 0; i < elementsCount; ++i)
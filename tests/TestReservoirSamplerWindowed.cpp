@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include "sampler-extensions/reservoir_sampler_windowed.h"
+
+#include <array>
+#include <numeric>
+
+#include "MonteCarloTrials.h"
+
+TEST(ReservoirSamplerWindowed, SamplerOfSizeFive_ThreeElementsAdded_HasOnlyOriginalElements)
+{
+	const std::vector<size_t> stream({10, 11, 12});
+
+	ReservoirSamplerWindowed<size_t> sampler(5, 10);
+	for (const size_t value : stream)
+	{
+		sampler.sampleElement(value);
+	}
+
+	std::vector<size_t> result = sampler.getResult();
+	std::sort(result.begin(), result.end());
+	EXPECT_EQ(stream, result);
+}
+
+TEST(ReservoirSamplerWindowed, SamplerWithWindowSmallerThanSampleSize_FilledWithData_HasTheWholeWindow)
+{
+	ReservoirSamplerWindowed<size_t> sampler(5, 3);
+	for (size_t value = 0; value < 11; ++value)
+	{
+		sampler.sampleElement(value);
+	}
+
+	std::vector<size_t> result = sampler.getResult();
+	std::sort(result.begin(), result.end());
+	EXPECT_EQ(std::vector<size_t>({8, 9, 10}), result);
+}
+
+TEST(ReservoirSamplerWindowed, SamplerWithAResult_Reset_CanBeReused)
+{
+	ReservoirSamplerWindowed<std::string> sampler(2, 4);
+	sampler.sampleElement("test");
+	sampler.sampleElementEmplace(3, 'a');
+
+	sampler.reset();
+	EXPECT_TRUE(sampler.getResult().empty());
+
+	sampler.sampleElement("test2");
+	EXPECT_EQ(std::vector<std::string>({"test2"}), sampler.getResult());
+	EXPECT_EQ(static_cast<uint64_t>(1), sampler.getProcessedElementsCount());
+}
+
+TEST(ReservoirSamplerWindowed, SamplerSizeOfFive_SamplingFromWindowOfTwenty_ProducesEqualFrequenciesInsideTheWindow)
+{
+	// the window doesn't align with the internal buckets and covers elements 27..46
+	constexpr int streamSize = 47;
+	constexpr int windowSize = 20;
+	const std::array<int, streamSize> frequences = runParallelTrials<std::array<int, streamSize>>(10000, [](std::mt19937& rand, std::array<int, streamSize>& trialFrequences)
+	{
+		ReservoirSamplerWindowed<int, std::mt19937&> sampler(5, windowSize, rand);
+
+		for (int n = 0; n < streamSize; ++n)
+		{
+			sampler.sampleElement(n);
+		}
+
+		const std::vector<int> result = sampler.getResult();
+		ASSERT_EQ(static_cast<size_t>(5), result.size());
+		for (int item : result)
+		{
+			++trialFrequences[item];
+		}
+	});
+
+	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
+	ASSERT_EQ(5.0f * 10000, frequencySum);
+	for (int n = 0; n < streamSize - windowSize; ++n)
+	{
+		EXPECT_EQ(0, frequences[n]);
+	}
+	for (int n = streamSize - windowSize; n < streamSize; ++n)
+	{
+		EXPECT_NEAR(1.0f / windowSize, frequences[n]/frequencySum, 0.01f);
+	}
+}
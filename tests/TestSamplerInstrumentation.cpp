@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include "sampler-extensions/sampler_instrumentation.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+
+#include "reservoir-sampler/reservoir_sampler.h"
+#include "reservoir-sampler/reservoir_sampler_linear.h"
+#include "reservoir-sampler/reservoir_sampler_weighted.h"
+
+TEST(SamplerInstrumentation, InstrumentationDisabled_SamplerFilled_StatsAreEmptyAndResultIsCorrect)
+{
+	InstrumentedSampler<ReservoirSampler<int>, false> sampler(5);
+	for (int n = 0; n < 5; ++n)
+	{
+		sampler.sampleElement(n);
+	}
+
+	std::vector<int> result = sampler.consumeResult();
+	std::sort(result.begin(), result.end());
+	EXPECT_EQ(std::vector<int>({0, 1, 2, 3, 4}), result);
+	EXPECT_EQ(static_cast<uint64_t>(0), sampler.getStats().offeredElementsCount);
+	EXPECT_EQ(static_cast<uint64_t>(0), sampler.getStats().storedElementsCount);
+}
+
+TEST(SamplerInstrumentation, InstrumentedSamplerOfSizeFive_ThousandElementsEmplaced_CountsAreConsistent)
+{
+	InstrumentedSampler<ReservoirSampler<CountedElement<int>, CountingRand<std::mt19937>>, true> sampler(5, CountingRand<std::mt19937>(std::random_device{}()));
+	for (int n = 0; n < 1000; ++n)
+	{
+		sampler.sampleElementEmplace(n);
+	}
+
+	const SamplerInstrumentationStats& stats = sampler.getStats();
+	EXPECT_EQ(static_cast<uint64_t>(1000), stats.offeredElementsCount);
+	EXPECT_EQ(stats.offeredElementsCount, stats.skippedElementsCount + stats.storedElementsCount);
+	EXPECT_EQ(static_cast<uint64_t>(5), stats.storedElementsCount - stats.replacedElementsCount);
+	// only the elements that got to the reservoir are constructed
+	EXPECT_EQ(stats.storedElementsCount, stats.elementConstructionsCount);
+	EXPECT_EQ(static_cast<uint64_t>(0), stats.elementCopiesCount);
+	EXPECT_GT(stats.randomDrawsCount, static_cast<uint64_t>(0));
+	EXPECT_LT(stats.storedElementsCount, static_cast<uint64_t>(200));
+}
+
+TEST(SamplerInstrumentation, InstrumentedSampler_ElementsCopiedIn_CopiesAreCounted)
+{
+	InstrumentedSampler<ReservoirSampler<CountedElement<std::string>>, true> sampler(5);
+	const CountedElement<std::string> value("test");
+	for (int n = 0; n < 3; ++n)
+	{
+		sampler.sampleElement(value);
+	}
+
+	EXPECT_EQ(static_cast<uint64_t>(3), sampler.getStats().elementCopiesCount);
+	EXPECT_EQ(static_cast<uint64_t>(0), sampler.getStats().replacedElementsCount);
+}
+
+TEST(SamplerInstrumentation, InstrumentedSampler_JumpAhead_SkippedElementsAreCounted)
+{
+	InstrumentedSampler<ReservoirSampler<int>, true> sampler(5);
+	int offeredCount = 0;
+	for (int n = 0; n < 1000; ++n)
+	{
+		sampler.sampleElement(n);
+		const size_t skippedCount = std::min(sampler.getNextSkippedElementsCount(), static_cast<size_t>(999 - n));
+		sampler.jumpAhead(skippedCount);
+		n += static_cast<int>(skippedCount);
+		offeredCount += 1 + static_cast<int>(skippedCount);
+	}
+
+	const SamplerInstrumentationStats& stats = sampler.getStats();
+	EXPECT_EQ(static_cast<uint64_t>(offeredCount), stats.offeredElementsCount);
+	EXPECT_EQ(stats.offeredElementsCount, stats.skippedElementsCount + stats.storedElementsCount);
+	EXPECT_EQ(static_cast<uint64_t>(5), stats.storedElementsCount - stats.replacedElementsCount);
+}
+
+TEST(SamplerInstrumentation, InstrumentedWeightedSampler_ElementsAdded_CountsAreConsistent)
+{
+	InstrumentedSampler<ReservoirSamplerWeighted<int>, true> sampler(5);
+	for (int n = 0; n < 1000; ++n)
+	{
+		sampler.sampleElement(1.0f, n);
+	}
+
+	const SamplerInstrumentationStats& stats = sampler.getStats();
+	EXPECT_EQ(static_cast<uint64_t>(1000), stats.offeredElementsCount);
+	EXPECT_EQ(stats.offeredElementsCount, stats.skippedElementsCount + stats.storedElementsCount);
+	EXPECT_EQ(static_cast<uint64_t>(5), stats.storedElementsCount - stats.replacedElementsCount);
+	EXPECT_EQ(static_cast<size_t>(5), sampler.getResultSize());
+}
+
+TEST(SamplerInstrumentation, InstrumentedLinearSampler_ElementsAdded_OnlyFirstIsNotAReplacement)
+{
+	InstrumentedSampler<ReservoirSamplerLinear<int>, true> sampler;
+	for (int n = 0; n < 100; ++n)
+	{
+		sampler.sampleElement(1.0f, n);
+	}
+
+	const SamplerInstrumentationStats& stats = sampler.getStats();
+	EXPECT_EQ(static_cast<uint64_t>(100), stats.offeredElementsCount);
+	EXPECT_EQ(static_cast<uint64_t>(1), stats.storedElementsCount - stats.replacedElementsCount);
+}
+
+TEST(SamplerInstrumentation, StatsOfTwoSamplers_Added_ProduceSums)
+{
+	InstrumentedSampler<ReservoirSampler<int>, true> firstSampler(5);
+	InstrumentedSampler<ReservoirSampler<int>, true> secondSampler(5);
+	for (int n = 0; n < 10; ++n)
+	{
+		firstSampler.sampleElement(n);
+		secondSampler.sampleElement(n);
+		secondSampler.sampleElement(n);
+	}
+
+	SamplerInstrumentationStats stats = firstSampler.getStats();
+	stats += secondSampler.getStats();
+
+	EXPECT_EQ(static_cast<uint64_t>(30), stats.offeredElementsCount);
+	secondSampler.resetStats();
+	EXPECT_EQ(static_cast<uint64_t>(0), secondSampler.getStats().offeredElementsCount);
+}
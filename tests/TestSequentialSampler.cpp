@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include "sampler-extensions/sequential_sampler.h"
+
+#include <array>
+#include <numeric>
+
+#include "MonteCarloTrials.h"
+
+TEST(SequentialSampler, SampleSizeNotSmallerThanPopulation_SampleIndices_ReturnsAllIndices)
+{
+	std::mt19937 rand{std::random_device{}()};
+	EXPECT_EQ(std::vector<uint64_t>({0, 1, 2, 3, 4}), sampleIndices(5, 5, rand));
+	EXPECT_EQ(std::vector<uint64_t>({0, 1, 2}), sampleIndices(3, 10, rand));
+	EXPECT_TRUE(sampleIndices(0, 10, rand).empty());
+	EXPECT_TRUE(sampleIndices(10, 0, rand).empty());
+}
+
+TEST(SequentialSampler, DifferentPopulationSizes_SampleIndices_ReturnsSortedDistinctIndicesInRange)
+{
+	std::mt19937 rand{std::random_device{}()};
+	for (const auto& [populationSize, sampleSize] : std::array<std::pair<uint64_t, uint64_t>, 5>{{{20, 5}, {1000, 5}, {1000, 500}, {1000000, 100}, {1000000000, 1000}}})
+	{
+		const std::vector<uint64_t> result = sampleIndices(populationSize, sampleSize, rand);
+		ASSERT_EQ(sampleSize, result.size());
+		EXPECT_TRUE(std::adjacent_find(result.begin(), result.end(), [](uint64_t left, uint64_t right){ return left >= right; }) == result.end());
+		EXPECT_GT(populationSize, result.back());
+	}
+}
+
+TEST(SequentialSampler, SamplerSizeOfFive_SamplingFromTwenty_ProducesEqualFrequencies)
+{
+	const std::array<int, 20> frequences = runParallelTrials<std::array<int, 20>>(10000, [](std::mt19937& rand, std::array<int, 20>& trialFrequences)
+	{
+		SequentialSampler<std::mt19937&> sampler(20, 5, rand);
+		while (sampler.hasNext())
+		{
+			++trialFrequences[sampler.next()];
+		}
+	});
+
+	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
+	ASSERT_EQ(5.0f * 10000, frequencySum);
+	for (int freq : frequences)
+	{
+		EXPECT_NEAR(0.05f, freq/frequencySum, 0.01f);
+	}
+}
+
+TEST(SequentialSampler, SamplerSizeOfFive_SamplingFromThousand_ProducesEqualFrequencies)
+{
+	// large population relative to the sample size uses Algorithm D, check frequencies of ranges of 50 indices
+	const std::array<int, 20> frequences = runParallelTrials<std::array<int, 20>>(10000, [](std::mt19937& rand, std::array<int, 20>& trialFrequences)
+	{
+		SequentialSampler<std::mt19937&> sampler(1000, 5, rand);
+		while (sampler.hasNext())
+		{
+			++trialFrequences[sampler.next() / 50];
+		}
+	});
+
+	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
+	ASSERT_EQ(5.0f * 10000, frequencySum);
+	for (int freq : frequences)
+	{
+		EXPECT_NEAR(0.05f, freq/frequencySum, 0.01f);
+	}
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include "sampler-extensions/stratified_reservoir_sampler.h"
+
+#include <array>
+#include <numeric>
+#include <string>
+
+#include "MonteCarloTrials.h"
+
+TEST(StratifiedReservoirSampler, SamplerWithTwoStrata_FewElementsAdded_EachStratumHasOnlyItsElements)
+{
+	StratifiedReservoirSampler<std::string, int> sampler(5);
+	sampler.sampleElement("first", 1);
+	sampler.sampleElement("second", 10);
+	sampler.sampleElement("first", 2);
+	sampler.sampleElement("second", 11);
+	sampler.sampleElement("first", 3);
+
+	{
+		std::vector<int> result(sampler.getResult("first").begin(), sampler.getResult("first").end());
+		std::sort(result.begin(), result.end());
+		EXPECT_EQ(std::vector<int>({1, 2, 3}), result);
+	}
+
+	{
+		const auto [data, size] = sampler.getResult("second");
+		std::vector<int> result(data, data + size);
+		std::sort(result.begin(), result.end());
+		EXPECT_EQ(std::vector<int>({10, 11}), result);
+	}
+
+	EXPECT_EQ(static_cast<size_t>(0), sampler.getResult("third").size);
+	EXPECT_EQ(static_cast<size_t>(2), sampler.getStrataCount());
+	EXPECT_EQ(static_cast<uint64_t>(3), sampler.getProcessedElementsCount("first"));
+}
+
+TEST(StratifiedReservoirSampler, SamplerWithManyStrata_FilledWithData_KeepsAllStrata)
+{
+	StratifiedReservoirSampler<int, int> sampler(3);
+	for (int n = 0; n < 10000; ++n)
+	{
+		sampler.sampleElement(n % 1000, n);
+	}
+
+	EXPECT_EQ(static_cast<size_t>(1000), sampler.getStrataCount());
+	size_t visitedStrataCount = 0;
+	sampler.forEachStratum([&visitedStrataCount](int key, auto result)
+	{
+		++visitedStrataCount;
+		ASSERT_EQ(static_cast<size_t>(3), result.size);
+		for (int item : result)
+		{
+			EXPECT_EQ(key, item % 1000);
+		}
+	});
+	EXPECT_EQ(static_cast<size_t>(1000), visitedStrataCount);
+}
+
+TEST(StratifiedReservoirSampler, SamplerWithLimitedStrata_NewKeysAdded_EvictsInactiveStrata)
+{
+	StratifiedReservoirSampler<int, int> sampler(2, 3);
+	for (int key = 0; key < 3; ++key)
+	{
+		sampler.sampleElement(key, key);
+	}
+
+	// the first pass over the strata gives them a second chance
+	sampler.sampleElement(3, 3);
+	EXPECT_EQ(static_cast<size_t>(3), sampler.getStrataCount());
+
+	// keep the stratum 3 active, so one of the old ones is evicted
+	sampler.sampleElement(3, 4);
+	sampler.sampleElement(4, 5);
+	EXPECT_EQ(static_cast<size_t>(3), sampler.getStrataCount());
+	EXPECT_EQ(static_cast<size_t>(2), sampler.getResult(3).size);
+	EXPECT_EQ(static_cast<size_t>(1), sampler.getResult(4).size);
+	EXPECT_EQ(5, sampler.getResult(4).data[0]);
+
+	for (int key = 0; key < 1000; ++key)
+	{
+		sampler.sampleElement(key, key);
+		ASSERT_GE(static_cast<size_t>(3), sampler.getStrataCount());
+		ASSERT_EQ(static_cast<size_t>(1), sampler.getResult(key).size);
+	}
+}
+
+TEST(StratifiedReservoirSampler, SamplerWithAResult_Reset_CanBeReused)
+{
+	StratifiedReservoirSampler<int, int> sampler(2);
+	sampler.sampleElement(1, 10);
+	sampler.reset();
+	EXPECT_EQ(static_cast<size_t>(0), sampler.getStrataCount());
+	EXPECT_EQ(static_cast<size_t>(0), sampler.getResult(1).size);
+
+	sampler.sampleElement(1, 20);
+	ASSERT_EQ(static_cast<size_t>(1), sampler.getResult(1).size);
+	EXPECT_EQ(20, sampler.getResult(1).data[0]);
+}
+
+TEST(StratifiedReservoirSampler, SamplerSizeOfFive_SamplingFromTwoStrata_ProducesEqualFrequenciesInEachStratum)
+{
+	const std::array<int, 30> frequences = runParallelTrials<std::array<int, 30>>(10000, [](std::mt19937& rand, std::array<int, 30>& trialFrequences)
+	{
+		StratifiedReservoirSampler<int, int, std::hash<int>, std::mt19937&> sampler(5, 0, rand);
+
+		// stratum 0 gets elements 0..19, stratum 1 gets elements 20..29
+		for (int n = 0; n < 30; ++n)
+		{
+			sampler.sampleElement(n < 20 ? 0 : 1, n);
+		}
+
+		for (int item : sampler.getResult(0))
+		{
+			++trialFrequences[item];
+		}
+		for (int item : sampler.getResult(1))
+		{
+			++trialFrequences[item];
+		}
+	});
+
+	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
+	ASSERT_EQ(10.0f * 10000, frequencySum);
+	for (int n = 0; n < 30; ++n)
+	{
+		// a stratum of 20 elements gets each one with probability 5/20 and a stratum of 10 with 5/10
+		const float expectedFrequency = (n < 20 ? 0.25f : 0.5f) / 10.0f;
+		EXPECT_NEAR(expectedFrequency, frequences[n]/frequencySum, 0.01f);
+	}
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+
+#include "sampler-extensions/weighted_bulk_sampling.h"
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "reservoir-sampler/reservoir_sampler_linear.h"
+#include "reservoir-sampler/reservoir_sampler_weighted.h"
+#include "reservoir-sampler/reservoir_sampler_weighted_static.h"
+
+#include "MonteCarloTrials.h"
+
+TEST(WeightedBulkSampling, SamplerOfSizeFive_FiveElementColumns_HasAllElements)
+{
+	const std::vector<float> weights({1.0f, 2.0f, 3.0f, 4.0f, 5.0f});
+	const std::vector<int> values({10, 11, 12, 13, 14});
+
+	ReservoirSamplerWeighted<int> sampler(5);
+	sampleElements(sampler, weights, values);
+
+	std::vector<int> result = sampler.consumeResult();
+	std::sort(result.begin(), result.end());
+	EXPECT_EQ(values, result);
+}
+
+TEST(WeightedBulkSampling, StaticSamplerOfSizeFive_SpansOfThreeElements_HasAllElements)
+{
+	const std::array<float, 3> weights{1.0f, 1.0f, 1.0f};
+	const std::array<std::string, 3> values{"a", "b", "c"};
+
+	ReservoirSamplerWeightedStatic<std::string, 5> sampler;
+	sampleElements(sampler, std::span<const float>(weights), std::span<const std::string>(values));
+
+	std::vector<std::string> result = sampler.consumeResult();
+	std::sort(result.begin(), result.end());
+	EXPECT_EQ(std::vector<std::string>({"a", "b", "c"}), result);
+}
+
+TEST(WeightedBulkSampling, SamplerOfSizeFive_LongColumns_ValuesAreReadOnlyForConsideredElements)
+{
+	const std::vector<float> weights(100000, 1.0f);
+
+	ReservoirSamplerWeighted<size_t> sampler(5);
+	size_t readValuesCount = 0;
+	sampleElementsWith(sampler, weights.data(), weights.size(), [&readValuesCount](size_t index)
+	{
+		++readValuesCount;
+		return index;
+	});
+
+	EXPECT_EQ(static_cast<size_t>(5), sampler.getResultSize());
+	EXPECT_LT(readValuesCount, static_cast<size_t>(1000));
+}
+
+TEST(WeightedBulkSampling, LinearSampler_ColumnsOfOneElement_ReturnsThatElement)
+{
+	const std::vector<int> weights({7});
+	const std::vector<int> values({12});
+
+	ReservoirSamplerLinear<int, int> sampler;
+	sampleElements(sampler, weights.data(), values.data(), weights.size());
+
+	const auto result = sampler.consumeResult();
+	ASSERT_TRUE(result.has_value());
+	EXPECT_EQ(12, *result);
+}
+
+TEST(WeightedBulkSampling, LinearSampler_LongColumns_ValuesAreReadForEveryElement)
+{
+	const std::vector<int> weights(1000, 1);
+
+	ReservoirSamplerLinear<size_t, int> sampler;
+	size_t readValuesCount = 0;
+	sampleElementsWith(sampler, weights.data(), weights.size(), [&readValuesCount](size_t index)
+	{
+		++readValuesCount;
+		return index;
+	});
+
+	EXPECT_EQ(weights.size(), readValuesCount);
+	EXPECT_TRUE(sampler.getResult().has_value());
+}
+
+TEST(WeightedBulkSampling, SamplerSizeOfFive_ColumnsOfTwentyEqualWeights_ProducesEqualFrequencies)
+{
+	std::vector<float> weights(20, 1.0f);
+	std::vector<int> values(20);
+	std::iota(values.begin(), values.end(), 0);
+
+	const std::array<int, 20> frequences = runParallelTrials<std::array<int, 20>>(10000, [&weights, &values](std::mt19937& rand, std::array<int, 20>& trialFrequences)
+	{
+		ReservoirSamplerWeighted<int, float, std::mt19937&> sampler(5, rand);
+		sampleElements(sampler, weights, values);
+
+		const auto [data, size] = sampler.getResult();
+		for (size_t k = 0; k < size; ++k)
+		{
+			++trialFrequences[data[k]];
+		}
+	});
+
+	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
+	ASSERT_EQ(5.0f * 10000, frequencySum);
+	for (int freq : frequences)
+	{
+		EXPECT_NEAR(0.05f, freq/frequencySum, 0.01f);
+	}
+}
+
+TEST(WeightedBulkSampling, LinearSampler_ColumnsOfWeightedValues_ProducesExpectedFrequencies)
+{
+	constexpr size_t elementsCount = 21;
+	std::array<int, elementsCount> weights;
+	std::array<size_t, elementsCount> values;
+	std::array<float, elementsCount> expectedFrequencies;
+
+	for (size_t i = 0; i < elementsCount; ++i)
+	{
+		// triangle distrubution that peaks at 10 with value of 11
+		weights[i] = 11 - std::abs(static_cast<int>(i) - 10);
+		values[i] = i;
+	}
+
+	const float weightSum = std::accumulate(weights.begin(), weights.end(), 0.0f);
+	for (size_t i = 0; i < elementsCount; ++i)
+	{
+		expectedFrequencies[i] = weights[i] / weightSum;
+	}
+
+	const std::array<int, elementsCount> frequences = runParallelTrials<std::array<int, elementsCount>>(100000, [&weights, &values](std::mt19937& rand, std::array<int, elementsCount>& trialFrequences)
+	{
+		ReservoirSamplerLinear<size_t, int, std::mt19937&> sampler(rand);
+		sampleElements(sampler, weights, values);
+
+		const auto result = sampler.getResult();
+		ASSERT_TRUE(result.has_value());
+		++trialFrequences[result.value_or(0)];
+	});
+
+	const float frequencySum = std::accumulate(frequences.begin(), frequences.end(), 0.0f);
+	for (size_t i = 0; i < elementsCount; ++i)
+	{
+		EXPECT_NEAR(expectedFrequencies[i], frequences[i]/frequencySum, 0.01f);
+	}
+}
@@ -0,0 +1,309 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "reservoir-sampler/reservoir_sampler.h"
+
+/**
+ * Finds the end of the line that starts at the given position (position of '\n' or the size of the data)
+ */
+inline size_t findLineEnd(std::string_view data, size_t lineBegin)
+{
+	const void* lineEnd = std::memchr(data.data() + lineBegin, '\n', data.size() - lineBegin);
+	return lineEnd ? static_cast<size_t>(static_cast<const char*>(lineEnd) - data.data()) : data.size();
+}
+
+/**
+ * Calls the function for every line in the data, line separators are not included.
+ * The last line doesn't need to end with a line separator.
+ */
+template<typename Func>
+void forEachLine(std::string_view data, Func&& func)
+{
+	size_t lineBegin = 0;
+	while (lineBegin < data.size())
+	{
+		const size_t lineEnd = findLineEnd(data, lineBegin);
+		func(data.substr(lineBegin, lineEnd - lineBegin));
+		lineBegin = lineEnd + 1;
+	}
+}
+
+/**
+ * Feeds every line of the data to the sampler and returns the number of lines in the data.
+ * The lines are stored as views into the data, so the data should outlive the sampled result.
+ * Lines that the sampler is going to skip are only scanned for their end.
+ */
+template<typename Sampler>
+uint64_t sampleLines(std::string_view data, Sampler& sampler)
+{
+	uint64_t linesCount = 0;
+	size_t lineBegin = 0;
+	while (lineBegin < data.size())
+	{
+		const size_t skipCount = sampler.getNextSkippedElementsCount();
+		size_t skippedLinesCount = 0;
+		for (; skippedLinesCount < skipCount && lineBegin < data.size(); ++skippedLinesCount)
+		{
+			lineBegin = findLineEnd(data, lineBegin) + 1;
+		}
+		// don't jump past the end of the data, the rest of the skip continues in the next data fed to the sampler
+		sampler.jumpAhead(skippedLinesCount);
+		linesCount += skippedLinesCount;
+
+		if (lineBegin >= data.size())
+		{
+			break;
+		}
+
+		const size_t lineEnd = findLineEnd(data, lineBegin);
+		sampler.sampleElement(data.substr(lineBegin, lineEnd - lineBegin));
+		lineBegin = lineEnd + 1;
+		++linesCount;
+	}
+	return linesCount;
+}
+
+/**
+ * Splits the data into approximately equal chunks that start at line beginnings.
+ * May return fewer chunks than requested if the data has too few lines.
+ */
+inline std::vector<std::string_view> splitIntoLineAlignedChunks(std::string_view data, size_t chunksCount)
+{
+	std::vector<std::string_view> chunks;
+	chunks.reserve(chunksCount);
+
+	size_t chunkBegin = 0;
+	for (size_t i = 1; i <= chunksCount && chunkBegin < data.size(); ++i)
+	{
+		size_t chunkEnd = data.size();
+		if (i < chunksCount)
+		{
+			const size_t approximateEnd = std::max(chunkBegin, data.size() / chunksCount * i);
+			// the line that contains the approximate end belongs to this chunk entirely
+			chunkEnd = std::min(findLineEnd(data, approximateEnd) + 1, data.size());
+		}
+		chunks.push_back(data.substr(chunkBegin, chunkEnd - chunkBegin));
+		chunkBegin = chunkEnd;
+	}
+
+	return chunks;
+}
+
+/**
+ * Incrementally splits a stream of text blocks into lines and feeds them to a sampler of std::string.
+ * Only the lines the sampler accepts are copied, the rest are just scanned for their end.
+ */
+template<typename Sampler>
+class StreamLineSampler
+{
+public:
+	explicit StreamLineSampler(Sampler& sampler)
+		: mSampler(sampler)
+	{
+	}
+
+	void consumeBlock(std::string_view block)
+	{
+		size_t lineBegin = 0;
+		while (lineBegin < block.size())
+		{
+			const size_t lineEnd = findLineEnd(block, lineBegin);
+			if (lineEnd == block.size())
+			{
+				// the line continues in the next block
+				appendLinePart(block.substr(lineBegin));
+				return;
+			}
+
+			appendLinePart(block.substr(lineBegin, lineEnd - lineBegin));
+			finishLine();
+			lineBegin = lineEnd + 1;
+		}
+	}
+
+	/**
+	 * Should be called at the end of the stream to process the last line without a line separator
+	 */
+	void finish()
+	{
+		if (mHasPartialLine)
+		{
+			finishLine();
+		}
+	}
+
+private:
+	void appendLinePart(std::string_view part)
+	{
+		if (!mHasPartialLine)
+		{
+			mIsCurrentLineConsidered = mSampler.willNextElementBeConsidered();
+			mPartialLine.clear();
+		}
+
+		if (mIsCurrentLineConsidered)
+		{
+			mPartialLine.append(part);
+		}
+		mHasPartialLine = true;
+	}
+
+	void finishLine()
+	{
+		if (mIsCurrentLineConsidered)
+		{
+			mSampler.sampleElement(std::move(mPartialLine));
+			mPartialLine.clear();
+		}
+		else
+		{
+			mSampler.skipNextElement();
+		}
+		mHasPartialLine = false;
+		mIsCurrentLineConsidered = false;
+	}
+
+private:
+	Sampler& mSampler;
+	std::string mPartialLine;
+	bool mHasPartialLine = false;
+	bool mIsCurrentLineConsidered = false;
+};
+
+/**
+ * Incrementally splits a stream of text blocks into whole lines.
+ * Lines are passed as views into the block, only lines split between blocks are copied to be joined.
+ */
+class StreamLineSplitter
+{
+public:
+	template<typename Func>
+	void consumeBlock(std::string_view block, Func&& func)
+	{
+		size_t lineBegin = 0;
+		while (lineBegin < block.size())
+		{
+			const size_t lineEnd = findLineEnd(block, lineBegin);
+			if (lineEnd == block.size())
+			{
+				// the line continues in the next block
+				mPartialLine.append(block.substr(lineBegin));
+				mHasPartialLine = true;
+				return;
+			}
+
+			if (mHasPartialLine)
+			{
+				mPartialLine.append(block.substr(lineBegin, lineEnd - lineBegin));
+				func(std::string_view(mPartialLine));
+				mPartialLine.clear();
+				mHasPartialLine = false;
+			}
+			else
+			{
+				func(block.substr(lineBegin, lineEnd - lineBegin));
+			}
+			lineBegin = lineEnd + 1;
+		}
+	}
+
+	/**
+	 * Should be called at the end of the stream to process the last line without a line separator
+	 */
+	template<typename Func>
+	void finish(Func&& func)
+	{
+		if (mHasPartialLine)
+		{
+			func(std::string_view(mPartialLine));
+			mPartialLine.clear();
+			mHasPartialLine = false;
+		}
+	}
+
+private:
+	std::string mPartialLine;
+	bool mHasPartialLine = false;
+};
+
+/**
+ * Extracts a zero-based column from a delimited record, returns false if the record has fewer columns
+ */
+inline bool findColumn(std::string_view record, char delimiter, size_t columnIndex, std::string_view& outColumn)
+{
+	size_t columnBegin = 0;
+	for (size_t i = 0; i < columnIndex; ++i)
+	{
+		const size_t delimiterPos = record.find(delimiter, columnBegin);
+		if (delimiterPos == std::string_view::npos)
+		{
+			return false;
+		}
+		columnBegin = delimiterPos + 1;
+	}
+
+	const size_t columnEnd = std::min(record.find(delimiter, columnBegin), record.size());
+	outColumn = record.substr(columnBegin, columnEnd - columnBegin);
+	// tolerate files with CRLF line endings
+	if (!outColumn.empty() && outColumn.back() == '\r')
+	{
+		outColumn.remove_suffix(1);
+	}
+	return true;
+}
+
+/**
+ * Reads the weight from a column of a delimited record.
+ * Returns false if the column is missing or doesn't contain a finite non-negative number.
+ */
+inline bool parseWeightColumn(std::string_view record, char delimiter, size_t columnIndex, double& outWeight)
+{
+	std::string_view column;
+	if (!findColumn(record, delimiter, columnIndex, column))
+	{
+		return false;
+	}
+
+	const char* const columnEnd = column.data() + column.size();
+	double weight = 0.0;
+	const auto [parseEnd, errorCode] = std::from_chars(column.data(), columnEnd, weight);
+	if (errorCode != std::errc() || parseEnd != columnEnd || !(weight >= 0.0) || weight > std::numeric_limits<double>::max())
+	{
+		return false;
+	}
+
+	outWeight = weight;
+	return true;
+}
+
+/**
+ * Feeds every record of the data to a weighted sampler using the weight from the given column.
+ * The records are stored as views into the data, so the data should outlive the sampled result.
+ * Returns the number of records skipped because of a missing or invalid weight.
+ */
+template<typename WeightedSampler>
+size_t sampleWeightedLines(std::string_view data, WeightedSampler& sampler, char delimiter, size_t weightColumnIndex)
+{
+	size_t invalidRecordsCount = 0;
+	forEachLine(data, [&](std::string_view record)
+	{
+		double weight = 0.0;
+		if (parseWeightColumn(record, delimiter, weightColumnIndex, weight))
+		{
+			sampler.sampleElement(weight, record);
+		}
+		else
+		{
+			++invalidRecordsCount;
+		}
+	});
+	return invalidRecordsCount;
+}
@@ -0,0 +1,337 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "reservoir-sampler/reservoir_sampler.h"
+#include "reservoir-sampler/reservoir_sampler_weighted.h"
+
+#include "mapped_file.h"
+#include "line_sampling.h"
+#include "parallel_line_sampling.h"
+
+namespace
+{
+	struct Options
+	{
+		size_t sampleSize = 10;
+		std::mt19937::result_type seed = std::random_device{}();
+		// one-based index of the column with weights, zero when the sampling is uniform
+		size_t weightColumn = 0;
+		char delimiter = '\t';
+		size_t threadsCount = 1;
+		std::vector<const char*> filePaths;
+	};
+
+	// FILE that stands for the standard input
+	constexpr std::string_view StandardInputPath = "-";
+
+	void printUsage(const char* executableName)
+	{
+		std::fprintf(stderr,
+			"Usage: %s [-n COUNT] [--seed SEED] [-j THREADS] [-w COLUMN [-d DELIMITER]] [FILE]...\n"
+			"Prints COUNT uniformly sampled lines from the FILEs, or from the standard input if no FILE is given or FILE is -.\n"
+			"  -n COUNT           amount of lines to sample (default 10)\n"
+			"  --seed SEED        seed for the random number generator\n"
+			"  -j, --threads THREADS\n"
+			"                     sample chunks of the FILEs in parallel (uniform sampling of files only)\n"
+			"  -w, --weight-column COLUMN\n"
+			"                     sample records proportionally to the non-negative number in the COLUMN (starting from 1),\n"
+			"                     records with a missing or invalid weight are skipped\n"
+			"  -d, --delimiter DELIMITER\n"
+			"                     single character that separates columns (default is tab)\n",
+			executableName);
+	}
+
+	bool parseNumber(const char* text, unsigned long long& outValue)
+	{
+		char* end = nullptr;
+		outValue = std::strtoull(text, &end, 10);
+		return end != text && *end == '\0';
+	}
+
+	bool parseOptions(int argc, char* argv[], Options& outOptions)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			const std::string_view argument = argv[i];
+			unsigned long long value = 0;
+			if ((argument == "-n" || argument == "--seed") && i + 1 < argc)
+			{
+				if (!parseNumber(argv[++i], value))
+				{
+					return false;
+				}
+
+				if (argument == "-n")
+				{
+					outOptions.sampleSize = static_cast<size_t>(value);
+				}
+				else
+				{
+					outOptions.seed = static_cast<std::mt19937::result_type>(value);
+				}
+			}
+			else if ((argument == "-w" || argument == "--weight-column") && i + 1 < argc)
+			{
+				if (!parseNumber(argv[++i], value) || value == 0)
+				{
+					return false;
+				}
+				outOptions.weightColumn = static_cast<size_t>(value);
+			}
+			else if ((argument == "-d" || argument == "--delimiter") && i + 1 < argc)
+			{
+				const std::string_view delimiter = argv[++i];
+				if (delimiter.size() != 1)
+				{
+					return false;
+				}
+				outOptions.delimiter = delimiter[0];
+			}
+			else if ((argument == "-j" || argument == "--threads") && i + 1 < argc)
+			{
+				if (!parseNumber(argv[++i], value) || value == 0)
+				{
+					return false;
+				}
+				outOptions.threadsCount = static_cast<size_t>(value);
+			}
+			else if (argument == "-h" || argument == "--help")
+			{
+				return false;
+			}
+			else if (argument.size() > 1 && argument[0] == '-')
+			{
+				std::fprintf(stderr, "Unknown option '%s'\n", argv[i]);
+				return false;
+			}
+			else
+			{
+				outOptions.filePaths.push_back(argv[i]);
+			}
+		}
+
+		// a lone "-" is the same as no FILE, the standard input is then sampled without being buffered
+		if (outOptions.filePaths.size() == 1 && std::string_view(outOptions.filePaths[0]) == StandardInputPath)
+		{
+			outOptions.filePaths.clear();
+		}
+
+		return outOptions.sampleSize > 0;
+	}
+
+	/**
+	 * Reads the whole standard input, used when it is sampled together with files
+	 */
+	bool readStandardInput(std::string& outText)
+	{
+		std::vector<char> buffer(1 << 16);
+		size_t readBytes = 0;
+		while ((readBytes = std::fread(buffer.data(), 1, buffer.size(), stdin)) > 0)
+		{
+			outText.append(buffer.data(), readBytes);
+		}
+
+		if (std::ferror(stdin))
+		{
+			std::fprintf(stderr, "Can't read the standard input\n");
+			return false;
+		}
+		return true;
+	}
+
+	/**
+	 * Maps all the FILEs and collects their texts, "-" is read from the standard input into outStandardInputText.
+	 * The texts point into the mappings and outStandardInputText, so they should be kept alive while the texts are used.
+	 */
+	bool openInputs(const Options& options, std::vector<MappedFile>& outFiles, std::string& outStandardInputText, std::vector<std::string_view>& outTexts)
+	{
+		outFiles.resize(options.filePaths.size());
+		outTexts.reserve(options.filePaths.size());
+		bool isStandardInputRead = false;
+		for (size_t i = 0; i < outFiles.size(); ++i)
+		{
+			if (std::string_view(options.filePaths[i]) == StandardInputPath)
+			{
+				// the standard input can be read only once, next "-" are empty as with cat
+				if (!isStandardInputRead)
+				{
+					if (!readStandardInput(outStandardInputText))
+					{
+						return false;
+					}
+					isStandardInputRead = true;
+					outTexts.push_back(outStandardInputText);
+				}
+				continue;
+			}
+
+			if (!outFiles[i].open(options.filePaths[i]))
+			{
+				std::fprintf(stderr, "Can't open file '%s'\n", options.filePaths[i]);
+				return false;
+			}
+			outTexts.push_back(outFiles[i].getData());
+		}
+		return true;
+	}
+
+	template<typename Line>
+	void printLines(const std::vector<Line>& lines)
+	{
+		for (const Line& line : lines)
+		{
+			std::fwrite(line.data(), 1, line.size(), stdout);
+			std::fputc('\n', stdout);
+		}
+	}
+
+	int sampleStandardInput(const Options& options)
+	{
+		std::mt19937 rand(options.seed);
+		ReservoirSampler<std::string, std::mt19937&> sampler(options.sampleSize, rand);
+		StreamLineSampler<ReservoirSampler<std::string, std::mt19937&>> lineSampler(sampler);
+
+		std::vector<char> buffer(1 << 16);
+		size_t readBytes = 0;
+		while ((readBytes = std::fread(buffer.data(), 1, buffer.size(), stdin)) > 0)
+		{
+			lineSampler.consumeBlock(std::string_view(buffer.data(), readBytes));
+		}
+		lineSampler.finish();
+
+		if (std::ferror(stdin))
+		{
+			std::fprintf(stderr, "Can't read the standard input\n");
+			return 1;
+		}
+
+		printLines(sampler.consumeResult());
+		return 0;
+	}
+
+	void reportInvalidRecords(size_t invalidRecordsCount)
+	{
+		if (invalidRecordsCount > 0)
+		{
+			std::fprintf(stderr, "Skipped %zu records with a missing or invalid weight\n", invalidRecordsCount);
+		}
+	}
+
+	int sampleStandardInputWeighted(const Options& options)
+	{
+		std::mt19937 rand(options.seed);
+		ReservoirSamplerWeighted<std::string, double, std::mt19937&> sampler(options.sampleSize, rand);
+		StreamLineSplitter lineSplitter;
+		size_t invalidRecordsCount = 0;
+
+		const auto sampleRecord = [&](std::string_view record)
+		{
+			double weight = 0.0;
+			if (!parseWeightColumn(record, options.delimiter, options.weightColumn - 1, weight))
+			{
+				++invalidRecordsCount;
+			}
+			else if (sampler.willNextElementBeConsidered(weight))
+			{
+				// copy only the records that have a chance to get into the sample
+				sampler.sampleElementEmplace(weight, record);
+			}
+			else
+			{
+				sampler.skipNextElement(weight);
+			}
+		};
+
+		std::vector<char> buffer(1 << 16);
+		size_t readBytes = 0;
+		while ((readBytes = std::fread(buffer.data(), 1, buffer.size(), stdin)) > 0)
+		{
+			lineSplitter.consumeBlock(std::string_view(buffer.data(), readBytes), sampleRecord);
+		}
+		lineSplitter.finish(sampleRecord);
+
+		if (std::ferror(stdin))
+		{
+			std::fprintf(stderr, "Can't read the standard input\n");
+			return 1;
+		}
+
+		reportInvalidRecords(invalidRecordsCount);
+		printLines(sampler.consumeResult());
+		return 0;
+	}
+
+	int sampleFilesWeighted(const Options& options)
+	{
+		// the sampled records point into the inputs, so keep all of them alive until the result is printed
+		std::vector<MappedFile> files;
+		std::string standardInputText;
+		std::vector<std::string_view> texts;
+		if (!openInputs(options, files, standardInputText, texts))
+		{
+			return 1;
+		}
+
+		std::mt19937 rand(options.seed);
+		ReservoirSamplerWeighted<std::string_view, double, std::mt19937&> sampler(options.sampleSize, rand);
+		size_t invalidRecordsCount = 0;
+		for (std::string_view text : texts)
+		{
+			invalidRecordsCount += sampleWeightedLines(text, sampler, options.delimiter, options.weightColumn - 1);
+		}
+
+		reportInvalidRecords(invalidRecordsCount);
+		printLines(sampler.consumeResult());
+		return 0;
+	}
+
+	int sampleFiles(const Options& options)
+	{
+		// the sampled lines point into the inputs, so keep all of them alive until the result is printed
+		std::vector<MappedFile> files;
+		std::string standardInputText;
+		std::vector<std::string_view> texts;
+		if (!openInputs(options, files, standardInputText, texts))
+		{
+			return 1;
+		}
+
+		if (options.threadsCount > 1)
+		{
+			printLines(sampleLinesParallel(texts, options.sampleSize, options.threadsCount, options.seed));
+			return 0;
+		}
+
+		std::mt19937 rand(options.seed);
+		ReservoirSampler<std::string_view, std::mt19937&> sampler(options.sampleSize, rand);
+		for (std::string_view text : texts)
+		{
+			sampleLines(text, sampler);
+		}
+
+		printLines(sampler.consumeResult());
+		return 0;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	Options options;
+	if (!parseOptions(argc, argv, options))
+	{
+		printUsage(argv[0]);
+		return 2;
+	}
+
+	if (options.weightColumn > 0)
+	{
+		return options.filePaths.empty() ? sampleStandardInputWeighted(options) : sampleFilesWeighted(options);
+	}
+
+	return options.filePaths.empty() ? sampleStandardInput(options) : sampleFiles(options);
+}
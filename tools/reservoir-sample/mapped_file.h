@@ -0,0 +1,105 @@
+#pragma once
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <string_view>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * Read-only memory mapping of a whole file
+ */
+class MappedFile
+{
+public:
+	MappedFile() = default;
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	MappedFile(MappedFile&& other) noexcept
+		: mData(std::exchange(other.mData, nullptr))
+		, mSize(std::exchange(other.mSize, 0))
+	{
+	}
+
+	MappedFile& operator=(MappedFile&& other) noexcept
+	{
+		if (this != &other)
+		{
+			close();
+			mData = std::exchange(other.mData, nullptr);
+			mSize = std::exchange(other.mSize, 0);
+		}
+		return *this;
+	}
+
+	~MappedFile()
+	{
+		close();
+	}
+
+	/**
+	 * Maps the file into memory, returns false on failure.
+	 * An empty file is opened successfully and produces empty data.
+	 */
+	bool open(const char* filePath)
+	{
+		close();
+
+		const int fileDescriptor = ::open(filePath, O_RDONLY);
+		if (fileDescriptor < 0)
+		{
+			return false;
+		}
+
+		struct stat fileStat{};
+		if (::fstat(fileDescriptor, &fileStat) != 0 || !S_ISREG(fileStat.st_mode))
+		{
+			::close(fileDescriptor);
+			return false;
+		}
+
+		const size_t size = static_cast<size_t>(fileStat.st_size);
+		if (size > 0)
+		{
+			void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+			if (mapping == MAP_FAILED)
+			{
+				::close(fileDescriptor);
+				return false;
+			}
+			// the file is read front to back, let the kernel read ahead aggressively
+			::madvise(mapping, size, MADV_SEQUENTIAL);
+			mData = static_cast<const char*>(mapping);
+			mSize = size;
+		}
+
+		// the mapping stays valid after the descriptor is closed
+		::close(fileDescriptor);
+		return true;
+	}
+
+	[[nodiscard]] std::string_view getData() const { return std::string_view(mData, mSize); }
+
+private:
+	void close()
+	{
+		if (mData != nullptr)
+		{
+			::munmap(const_cast<char*>(mData), mSize);
+			mData = nullptr;
+			mSize = 0;
+		}
+	}
+
+private:
+	const char* mData = nullptr;
+	size_t mSize = 0;
+};
+
+#endif // defined(__unix__) || defined(__APPLE__)
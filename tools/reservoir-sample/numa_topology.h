@@ -0,0 +1,147 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/**
+ * NUMA node and the CPUs that belong to it
+ */
+struct NumaNode
+{
+	int id = 0;
+	std::vector<int> cpus;
+};
+
+/**
+ * Parses a CPU list in the kernel format (e.g. "0-11,24-35"), returns an empty list if the format is not recognized
+ */
+inline std::vector<int> parseCpuList(std::string_view cpuList)
+{
+	std::vector<int> cpus;
+	while (!cpuList.empty() && (cpuList.back() == '\n' || cpuList.back() == ' '))
+	{
+		cpuList.remove_suffix(1);
+	}
+
+	while (!cpuList.empty())
+	{
+		const size_t separatorPos = cpuList.find(',');
+		const std::string_view range = cpuList.substr(0, separatorPos);
+		cpuList = (separatorPos == std::string_view::npos) ? std::string_view() : cpuList.substr(separatorPos + 1);
+
+		int first = 0;
+		const auto [firstEnd, firstError] = std::from_chars(range.data(), range.data() + range.size(), first);
+		if (firstError != std::errc())
+		{
+			return {};
+		}
+
+		int last = first;
+		if (firstEnd != range.data() + range.size())
+		{
+			if (*firstEnd != '-')
+			{
+				return {};
+			}
+			const auto [lastEnd, lastError] = std::from_chars(firstEnd + 1, range.data() + range.size(), last);
+			if (lastError != std::errc() || lastEnd != range.data() + range.size() || last < first)
+			{
+				return {};
+			}
+		}
+
+		for (int cpu = first; cpu <= last; ++cpu)
+		{
+			cpus.push_back(cpu);
+		}
+	}
+	return cpus;
+}
+
+/**
+ * Reads the NUMA nodes that have CPUs from sysfs, sorted by id.
+ * Returns an empty list if the topology is not available (e.g. not Linux or a kernel without NUMA support).
+ */
+inline std::vector<NumaNode> readNumaTopology(const std::filesystem::path& nodesPath = "/sys/devices/system/node")
+{
+	std::vector<NumaNode> nodes;
+
+	std::error_code error;
+	for (std::filesystem::directory_iterator it(nodesPath, error), end; !error && it != end; it.increment(error))
+	{
+		const std::string name = it->path().filename().string();
+		if (name.rfind("node", 0) != 0)
+		{
+			continue;
+		}
+
+		NumaNode node;
+		const auto [idEnd, idError] = std::from_chars(name.data() + 4, name.data() + name.size(), node.id);
+		if (idError != std::errc() || idEnd != name.data() + name.size())
+		{
+			continue;
+		}
+
+		std::ifstream cpuListFile(it->path() / "cpulist");
+		std::string cpuList;
+		if (!std::getline(cpuListFile, cpuList))
+		{
+			continue;
+		}
+
+		node.cpus = parseCpuList(cpuList);
+		// memory-only nodes can't run threads
+		if (!node.cpus.empty())
+		{
+			nodes.push_back(std::move(node));
+		}
+	}
+
+	if (error)
+	{
+		return {};
+	}
+
+	std::sort(nodes.begin(), nodes.end(), [](const NumaNode& left, const NumaNode& right) { return left.id < right.id; });
+	return nodes;
+}
+
+/**
+ * Restricts the calling thread to the given CPUs, so the memory it touches first is allocated on their node.
+ * Does nothing for an empty list or on platforms other than Linux. Returns false if the affinity wasn't set.
+ */
+inline bool pinCurrentThreadToCpus(const std::vector<int>& cpus)
+{
+#ifdef __linux__
+	if (cpus.empty())
+	{
+		return false;
+	}
+
+	cpu_set_t cpuSet;
+	CPU_ZERO(&cpuSet);
+	for (int cpu : cpus)
+	{
+		if (cpu >= 0 && cpu < CPU_SETSIZE)
+		{
+			CPU_SET(cpu, &cpuSet);
+		}
+	}
+	return pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+#else
+	(void)cpus;
+	return false;
+#endif
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "reservoir-sampler/reservoir_sampler.h"
+#include "sampler-extensions/reservoir_sampler_merge.h"
+
+#include "line_sampling.h"
+#include "numa_topology.h"
+
+/**
+ * Uniformly samples lines from several texts using multiple threads spread over the given NUMA nodes.
+ *
+ * Every text is split into line-aligned chunks, the chunks are sampled independently
+ * and the per-chunk samples are merged according to the amount of lines in each chunk.
+ * The result is distributed the same way as a single-threaded sampling of all the texts.
+ *
+ * The threads are split evenly between the nodes and each node gets a proportional share of the chunks.
+ * The threads are pinned to the CPUs of their node, so the reservoirs are allocated on that node on first touch.
+ * The chunk samples are merged on their node first and only the merged per-node samples are read
+ * by the final merge, so the cross-node traffic doesn't grow with the number of threads.
+ * Nodes without CPUs listed are not pinned to.
+ */
+inline std::vector<std::string_view> sampleLinesParallel(const std::vector<std::string_view>& texts, size_t sampleSize, size_t threadsCount, std::mt19937::result_type seed, std::vector<NumaNode> numaNodes)
+{
+	threadsCount = std::max<size_t>(threadsCount, 1);
+
+	std::vector<std::string_view> chunks;
+	for (std::string_view text : texts)
+	{
+		for (std::string_view chunk : splitIntoLineAlignedChunks(text, threadsCount))
+		{
+			chunks.push_back(chunk);
+		}
+	}
+
+	if (numaNodes.empty())
+	{
+		numaNodes.emplace_back();
+	}
+	// every node should have at least one thread
+	numaNodes.resize(std::min(numaNodes.size(), threadsCount));
+	const size_t nodesCount = numaNodes.size();
+
+	std::vector<std::vector<std::string_view>> nodeSamples(nodesCount);
+	std::vector<uint64_t> nodeLinesCounts(nodesCount);
+
+	const auto sampleNode = [&](size_t nodeIndex)
+	{
+		const size_t nodeThreadsCount = threadsCount / nodesCount + (nodeIndex < threadsCount % nodesCount ? 1 : 0);
+		const size_t threadsBeforeCount = nodeIndex * (threadsCount / nodesCount) + std::min(nodeIndex, threadsCount % nodesCount);
+		const size_t chunksBegin = chunks.size() * threadsBeforeCount / threadsCount;
+		const size_t chunksEnd = chunks.size() * (threadsBeforeCount + nodeThreadsCount) / threadsCount;
+
+		// allocated by a thread of the node, so the samples stay in the node's memory
+		std::vector<std::vector<std::string_view>> chunkSamples(chunksEnd - chunksBegin);
+		std::vector<uint64_t> chunkLinesCounts(chunksEnd - chunksBegin);
+		std::atomic<size_t> nextChunkIndex{chunksBegin};
+
+		const auto sampleChunks = [&]()
+		{
+			for (size_t chunkIndex = nextChunkIndex++; chunkIndex < chunksEnd; chunkIndex = nextChunkIndex++)
+			{
+				// every chunk gets its own generator, so the result doesn't depend on the thread scheduling
+				std::seed_seq seedSequence{static_cast<uint64_t>(seed), static_cast<uint64_t>(chunkIndex)};
+				std::mt19937 rand(seedSequence);
+				ReservoirSampler<std::string_view, std::mt19937&> sampler(sampleSize, rand);
+				chunkLinesCounts[chunkIndex - chunksBegin] = sampleLines(chunks[chunkIndex], sampler);
+				chunkSamples[chunkIndex - chunksBegin] = sampler.consumeResult();
+			}
+		};
+
+		std::vector<std::thread> threads;
+		threads.reserve(nodeThreadsCount - 1);
+		for (size_t i = 1; i < nodeThreadsCount; ++i)
+		{
+			threads.emplace_back([&]()
+			{
+				pinCurrentThreadToCpus(numaNodes[nodeIndex].cpus);
+				sampleChunks();
+			});
+		}
+		sampleChunks();
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+
+		// the seeds continue after the chunk seeds, so they don't repeat the chunk generators
+		std::seed_seq mergeSeedSequence{static_cast<uint64_t>(seed), static_cast<uint64_t>(chunks.size() + nodeIndex)};
+		std::mt19937 mergeRand(mergeSeedSequence);
+		nodeLinesCounts[nodeIndex] = std::accumulate(chunkLinesCounts.begin(), chunkLinesCounts.end(), uint64_t{0});
+		nodeSamples[nodeIndex] = mergeUniformSamples(chunkSamples, std::move(chunkLinesCounts), sampleSize, mergeRand);
+	};
+
+	if (nodesCount == 1)
+	{
+		// the calling thread's affinity is left as it is
+		sampleNode(0);
+	}
+	else
+	{
+		std::vector<std::thread> nodeThreads;
+		nodeThreads.reserve(nodesCount);
+		for (size_t nodeIndex = 0; nodeIndex < nodesCount; ++nodeIndex)
+		{
+			nodeThreads.emplace_back([&, nodeIndex]()
+			{
+				pinCurrentThreadToCpus(numaNodes[nodeIndex].cpus);
+				sampleNode(nodeIndex);
+			});
+		}
+		for (std::thread& thread : nodeThreads)
+		{
+			thread.join();
+		}
+	}
+
+	std::mt19937 mergeRand(seed);
+	return mergeUniformSamples(nodeSamples, std::move(nodeLinesCounts), sampleSize, mergeRand);
+}
+
+/**
+ * Uniformly samples lines from several texts using multiple threads, spreading them over the NUMA nodes of the machine
+ */
+inline std::vector<std::string_view> sampleLinesParallel(const std::vector<std::string_view>& texts, size_t sampleSize, size_t threadsCount, std::mt19937::result_type seed)
+{
+	return sampleLinesParallel(texts, sampleSize, threadsCount, seed, readNumaTopology());
+}
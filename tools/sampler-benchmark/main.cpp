@@ -0,0 +1,170 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "reservoir-sampler/reservoir_sampler.h"
+
+#include "sampler-extensions/block_sampling.h"
+#include "sampler-extensions/sampler_instrumentation.h"
+
+namespace
+{
+	constexpr size_t SampleSize = 100;
+	constexpr int StreamSize = 1000000;
+	constexpr size_t BlockSize = 256;
+
+	// element with an inline buffer, every move is a copy of the whole buffer
+	template<size_t Size>
+	struct InlineBuffer
+	{
+		explicit InlineBuffer(int id)
+		{
+			data.fill(static_cast<char>(id));
+		}
+
+		std::array<char, Size> data;
+	};
+
+	struct LongString
+	{
+		explicit LongString(int id)
+			: value(8192, static_cast<char>('a' + id % 26))
+		{
+		}
+
+		std::string value;
+	};
+
+	enum class AddMethod
+	{
+		SampleElement,
+		SampleElementEmplace,
+		WillBeConsidered,
+		Block,
+	};
+
+	const char* getAddMethodName(AddMethod method)
+	{
+		switch (method)
+		{
+		case AddMethod::SampleElement:
+			return "sampleElement";
+		case AddMethod::SampleElementEmplace:
+			return "sampleElementEmplace";
+		case AddMethod::WillBeConsidered:
+			return "willNextElementBeConsidered";
+		case AddMethod::Block:
+			return "sampleBlockWith";
+		}
+		return "";
+	}
+
+	/**
+	 * Returns the number of elements constructed outside of the sampler
+	 */
+	template<typename Sampler>
+	uint64_t fillSampler(Sampler& sampler, AddMethod method)
+	{
+		using Element = std::decay_t<decltype(*sampler.getResult().begin())>;
+		uint64_t constructedElementsCount = 0;
+		if (method == AddMethod::Block)
+		{
+			for (int blockStart = 0; blockStart < StreamSize; blockStart += static_cast<int>(BlockSize))
+			{
+				const size_t count = std::min(BlockSize, static_cast<size_t>(StreamSize - blockStart));
+				const auto acceptMask = sampleBlockWith<BlockSize>(sampler, count, [blockStart](size_t index) { return Element(blockStart + static_cast<int>(index)); });
+				constructedElementsCount += acceptMask.count();
+			}
+			return constructedElementsCount;
+		}
+
+		for (int n = 0; n < StreamSize; ++n)
+		{
+			switch (method)
+			{
+			case AddMethod::SampleElement:
+				sampler.sampleElement(Element(n));
+				++constructedElementsCount;
+				break;
+			case AddMethod::SampleElementEmplace:
+				sampler.sampleElementEmplace(n);
+				break;
+			case AddMethod::WillBeConsidered:
+				if (sampler.willNextElementBeConsidered())
+				{
+					sampler.sampleElement(Element(n));
+					++constructedElementsCount;
+				}
+				else
+				{
+					sampler.skipNextElement();
+				}
+				break;
+			case AddMethod::Block:
+				break;
+			}
+		}
+		return constructedElementsCount;
+	}
+
+	template<typename Element>
+	void runBenchmark(const char* elementName, AddMethod method, std::mt19937::result_type seed)
+	{
+		const auto startTime = std::chrono::steady_clock::now();
+		ReservoirSampler<Element, std::mt19937> sampler(SampleSize, std::mt19937(seed));
+		fillSampler(sampler, method);
+		const auto result = sampler.consumeResult();
+		const auto duration = std::chrono::steady_clock::now() - startTime;
+
+		// separate run to count the moves, so the counting doesn't affect the timing
+		InstrumentedSampler<ReservoirSampler<CountedElement<Element>, std::mt19937>, true> countingSampler(SampleSize, std::mt19937(seed));
+		const uint64_t constructedOutsideCount = fillSampler(countingSampler, method);
+		const SamplerInstrumentationStats& stats = countingSampler.getStats();
+
+		const double nanosecondsPerElement = std::chrono::duration<double, std::nano>(duration).count() / StreamSize;
+		const double movesPerStoredElement = stats.storedElementsCount > 0 ? static_cast<double>(stats.elementMovesCount) / static_cast<double>(stats.storedElementsCount) : 0.0;
+		std::printf("%-14s %-28s %10.2f ns/element %8llu stored %6.2f moves/stored %8llu constructed\n",
+			elementName, getAddMethodName(method), nanosecondsPerElement,
+			static_cast<unsigned long long>(stats.storedElementsCount), movesPerStoredElement,
+			static_cast<unsigned long long>(stats.elementConstructionsCount + constructedOutsideCount));
+		(void)result;
+	}
+
+	template<typename Element>
+	void runBenchmarks(const char* elementName, std::mt19937::result_type seed)
+	{
+		for (AddMethod method : {AddMethod::SampleElement, AddMethod::SampleElementEmplace, AddMethod::WillBeConsidered, AddMethod::Block})
+		{
+			runBenchmark<Element>(elementName, method, seed);
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	std::mt19937::result_type seed = std::random_device{}();
+	if (argc == 3 && std::string_view(argv[1]) == "--seed")
+	{
+		seed = static_cast<std::mt19937::result_type>(std::strtoull(argv[2], nullptr, 10));
+	}
+	else if (argc != 1)
+	{
+		std::fprintf(stderr, "Usage: %s [--seed SEED]\n", argv[0]);
+		return 2;
+	}
+
+	std::printf("seed %lu, %d elements sampled into %zu slots\n", static_cast<unsigned long>(seed), StreamSize, SampleSize);
+	runBenchmarks<InlineBuffer<64>>("64B buffer", seed);
+	runBenchmarks<InlineBuffer<1024>>("1KB buffer", seed);
+	runBenchmarks<InlineBuffer<4096>>("4KB buffer", seed);
+	runBenchmarks<InlineBuffer<8192>>("8KB buffer", seed);
+	runBenchmarks<LongString>("8KB string", seed);
+	return 0;
+}
@@ -0,0 +1,270 @@
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include "reservoir-sampler/reservoir_sampler.h"
+#include "reservoir-sampler/reservoir_sampler_linear.h"
+#include "reservoir-sampler/reservoir_sampler_static.h"
+#include "reservoir-sampler/reservoir_sampler_weighted.h"
+
+#include "sampler-extensions/goodness_of_fit.h"
+
+namespace
+{
+	constexpr size_t SampleSize = 5;
+	constexpr size_t StreamSize = 20;
+	constexpr size_t WeightedStreamSize = 21;
+
+	struct Options
+	{
+		unsigned long long trialsCount = 100000;
+		std::mt19937::result_type seed = std::random_device{}();
+		double minPValue = 1e-4;
+	};
+
+	void printUsage(const char* executableName)
+	{
+		std::fprintf(stderr,
+			"Usage: %s [--trials COUNT] [--seed SEED] [--min-p-value P]\n"
+			"Checks distributions produced by the samplers with chi-square and Kolmogorov-Smirnov tests.\n"
+			"  --trials COUNT     amount of sampler runs per check (default 100000)\n"
+			"  --seed SEED        seed for the random number generator\n"
+			"  --min-p-value P    checks with a lower p-value are reported as failed (default 0.0001)\n",
+			executableName);
+	}
+
+	bool parseOptions(int argc, char* argv[], Options& outOptions)
+	{
+		for (int i = 1; i + 1 < argc; i += 2)
+		{
+			const std::string_view argument = argv[i];
+			const char* value = argv[i + 1];
+			char* end = nullptr;
+			if (argument == "--trials")
+			{
+				outOptions.trialsCount = std::strtoull(value, &end, 10);
+			}
+			else if (argument == "--seed")
+			{
+				outOptions.seed = static_cast<std::mt19937::result_type>(std::strtoull(value, &end, 10));
+			}
+			else if (argument == "--min-p-value")
+			{
+				outOptions.minPValue = std::strtod(value, &end);
+			}
+			else
+			{
+				return false;
+			}
+
+			if (end == value || *end != '\0')
+			{
+				return false;
+			}
+		}
+		return argc % 2 == 1 && outOptions.trialsCount > 0;
+	}
+
+	std::array<int, WeightedStreamSize> getTriangleWeights()
+	{
+		std::array<int, WeightedStreamSize> weights{};
+		for (size_t i = 0; i < WeightedStreamSize; ++i)
+		{
+			// triangle distribution that peaks at 10 with value of 11
+			weights[i] = 11 - std::abs(static_cast<int>(i) - 10);
+		}
+		return weights;
+	}
+
+	std::array<double, WeightedStreamSize> getTriangleProbabilities()
+	{
+		const std::array<int, WeightedStreamSize> weights = getTriangleWeights();
+		const double weightSum = std::accumulate(weights.begin(), weights.end(), 0.0);
+		std::array<double, WeightedStreamSize> probabilities{};
+		for (size_t i = 0; i < WeightedStreamSize; ++i)
+		{
+			probabilities[i] = weights[i] / weightSum;
+		}
+		return probabilities;
+	}
+
+	template<typename Sampler>
+	void addResultToHistogram(const Sampler& sampler, std::array<int, StreamSize>& histogram)
+	{
+		const auto [data, size] = sampler.getResult();
+		for (size_t k = 0; k < size; ++k)
+		{
+			++histogram[static_cast<size_t>(data[k])];
+		}
+	}
+
+	class Validator
+	{
+	public:
+		explicit Validator(const Options& options)
+			: mOptions(options)
+			, mRand(options.seed)
+		{
+		}
+
+		template<typename TrialFunc>
+		void checkUniformInclusion(const char* name, TrialFunc&& trial)
+		{
+			std::array<int, StreamSize> histogram{};
+			for (unsigned long long i = 0; i < mOptions.trialsCount; ++i)
+			{
+				trial(mRand, histogram);
+			}
+			report(name, "chi-square", chiSquareUniformInclusionTest(histogram, SampleSize));
+		}
+
+		template<typename TrialFunc>
+		void checkTriangleWeights(const char* name, TrialFunc&& trial)
+		{
+			std::array<int, WeightedStreamSize> histogram{};
+			for (unsigned long long i = 0; i < mOptions.trialsCount; ++i)
+			{
+				++histogram[trial(mRand)];
+			}
+			report(name, "chi-square", chiSquareTest(histogram, getTriangleProbabilities()));
+		}
+
+		template<typename TrialFunc>
+		void checkContinuousUniform(const char* name, TrialFunc&& trial)
+		{
+			std::vector<double> values(static_cast<size_t>(mOptions.trialsCount));
+			for (double& value : values)
+			{
+				value = trial(mRand);
+			}
+			report(name, "Kolmogorov-Smirnov", kolmogorovSmirnovTest(std::move(values), [](double value){ return value; }));
+		}
+
+		bool hasFailures() const { return mHasFailures; }
+
+	private:
+		void report(const char* name, const char* testName, const GoodnessOfFitResult& result)
+		{
+			const bool isPassed = result.pValue >= mOptions.minPValue;
+			mHasFailures = mHasFailures || !isPassed;
+			std::printf("%-4s %-48s %-18s statistic %-12.4f p-value %.6f\n", isPassed ? "OK" : "FAIL", name, testName, result.statistic, result.pValue);
+		}
+
+	private:
+		const Options& mOptions;
+		std::mt19937 mRand;
+		bool mHasFailures = false;
+	};
+}
+
+int main(int argc, char* argv[])
+{
+	Options options;
+	if (!parseOptions(argc, argv, options))
+	{
+		printUsage(argv[0]);
+		return 2;
+	}
+
+	std::printf("seed %lu, %llu trials per check\n", static_cast<unsigned long>(options.seed), options.trialsCount);
+	Validator validator(options);
+
+	validator.checkUniformInclusion("ReservoirSampler sampleElement", [](std::mt19937& rand, std::array<int, StreamSize>& histogram)
+	{
+		ReservoirSampler<int, std::mt19937&> sampler(SampleSize, rand);
+		for (int n = 0; n < static_cast<int>(StreamSize); ++n)
+		{
+			sampler.sampleElement(n);
+		}
+		addResultToHistogram(sampler, histogram);
+	});
+
+	validator.checkUniformInclusion("ReservoirSampler skipNextElement", [](std::mt19937& rand, std::array<int, StreamSize>& histogram)
+	{
+		ReservoirSampler<int, std::mt19937&> sampler(SampleSize, rand);
+		for (int n = 0; n < static_cast<int>(StreamSize); ++n)
+		{
+			if (sampler.willNextElementBeConsidered())
+			{
+				sampler.sampleElement(n);
+			}
+			else
+			{
+				sampler.skipNextElement();
+			}
+		}
+		addResultToHistogram(sampler, histogram);
+	});
+
+	validator.checkUniformInclusion("ReservoirSampler jumpAhead", [](std::mt19937& rand, std::array<int, StreamSize>& histogram)
+	{
+		ReservoirSampler<int, std::mt19937&> sampler(SampleSize, rand);
+		for (int n = 0; n < static_cast<int>(StreamSize); ++n)
+		{
+			sampler.sampleElement(n);
+			n += static_cast<int>(sampler.getNextSkippedElementsCount());
+			sampler.jumpAhead(sampler.getNextSkippedElementsCount());
+		}
+		addResultToHistogram(sampler, histogram);
+	});
+
+	validator.checkUniformInclusion("ReservoirSamplerStatic sampleElement", [](std::mt19937& rand, std::array<int, StreamSize>& histogram)
+	{
+		ReservoirSamplerStatic<int, SampleSize, std::mt19937&> sampler(rand);
+		for (int n = 0; n < static_cast<int>(StreamSize); ++n)
+		{
+			sampler.sampleElement(n);
+		}
+		addResultToHistogram(sampler, histogram);
+	});
+
+	validator.checkUniformInclusion("ReservoirSamplerWeighted equal weights", [](std::mt19937& rand, std::array<int, StreamSize>& histogram)
+	{
+		ReservoirSamplerWeighted<int, int, std::mt19937&> sampler(SampleSize, rand);
+		for (int n = 0; n < static_cast<int>(StreamSize); ++n)
+		{
+			sampler.sampleElement(1, n);
+		}
+		addResultToHistogram(sampler, histogram);
+	});
+
+	const std::array<int, WeightedStreamSize> weights = getTriangleWeights();
+
+	validator.checkTriangleWeights("ReservoirSamplerWeighted of size one", [&weights](std::mt19937& rand)
+	{
+		ReservoirSamplerWeighted<size_t, int, std::mt19937&> sampler(1, rand);
+		for (size_t n = 0; n < WeightedStreamSize; ++n)
+		{
+			sampler.sampleElement(weights[n], n);
+		}
+		return sampler.getResult().data[0];
+	});
+
+	validator.checkTriangleWeights("ReservoirSamplerLinear", [&weights](std::mt19937& rand)
+	{
+		ReservoirSamplerLinear<size_t, int, std::mt19937&> sampler(rand);
+		for (size_t n = 0; n < WeightedStreamSize; ++n)
+		{
+			sampler.sampleElement(weights[n], n);
+		}
+		return sampler.getResult().value_or(0);
+	});
+
+	validator.checkContinuousUniform("ReservoirSamplerLinear long stream", [](std::mt19937& rand)
+	{
+		constexpr int LongStreamSize = 1000;
+		ReservoirSamplerLinear<int, int, std::mt19937&> sampler(rand);
+		for (int n = 0; n < LongStreamSize; ++n)
+		{
+			sampler.sampleElement(1, n);
+		}
+		// center of the element's cell in [0, 1) to make the discrete distribution close to the continuous one
+		return (sampler.getResult().value_or(0) + 0.5) / LongStreamSize;
+	});
+
+	return validator.hasFailures() ? 1 : 0;
+}